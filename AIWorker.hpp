@@ -0,0 +1,209 @@
+#ifndef AIWORKER_HPP
+#define AIWORKER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "Board.hpp"
+#include "EndgameDb.hpp"
+#include "Mcts.hpp"
+#include "Search.hpp"
+#include "SpscQueue.hpp"
+#include "TranspositionTable.hpp"
+#include "Zobrist.hpp"
+
+// Reflexion de l'ordinateur sur un thread a part : la boucle de rendu ne fait
+// que deposer des copies de position (Think) et relever les messages (Poll).
+// Les resultats reviennent par une file sans verrou : la boucle d'affichage
+// n'attend jamais le thread de recherche.
+//
+// Reflexion sur le temps adverse (ponder) : pendant que l'humain choisit son
+// coup, le thread cherche deja la position prevue par la PV, sans echeance.
+// Si l'humain joue le coup prevu, PonderHit() donne son echeance a la
+// recherche en cours, qui garde tout ce qu'elle a deja calcule ; sinon
+// Think() l'abandonne aussitot pour la vraie position (la table de
+// transposition, elle, reste chaude).
+
+// Moteur de l'ordinateur
+enum AIEngine {
+    ENGINE_ALPHABETA, // Recherche alpha-beta (table de transposition, finales, livre)
+    ENGINE_MCTS       // Monte Carlo Tree Search multi-thread
+};
+
+enum AIMessageType : uint8_t {
+    AI_INFO,      // Iteration terminee : profondeur, score et PV provisoires
+    AI_BEST_MOVE  // Reflexion terminee : le coup a jouer
+};
+
+struct AIMessage {
+    AIMessageType type;
+    uint32_t job;         // Numero rendu par Think()
+    AIEngine engine;
+    SearchResult result;  // Au MCTS : coup, PV, noeuds et temps seulement
+    double winRate;       // MCTS seulement
+    long playouts;        // MCTS seulement
+};
+
+template <class B>
+class AIWorker {
+public:
+    AIWorker(TranspositionTable& tt, const EndgameTable& egtb, MctsArena& arena)
+        : tt(tt), egtb(egtb), arena(arena) {
+        thread = std::thread([this]() { Run(); });
+    }
+
+    ~AIWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+            activeJob.store(0, std::memory_order_relaxed);
+            signals.stop.store(true, std::memory_order_relaxed);
+        }
+        wake.notify_all();
+        thread.join();
+    }
+
+    AIWorker(const AIWorker&) = delete;
+    AIWorker& operator=(const AIWorker&) = delete;
+
+    // Nouvelle reflexion sur une copie de 'root' ; la precedente est abandonnee.
+    // limits.ponder : pas d'echeance avant PonderHit(), et pas de coup rendu avant.
+    uint32_t Think(const B& root, const SearchLimits& limits, AIEngine engine) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.root = root;
+        pending.limits = limits;
+        pending.engine = engine;
+        pending.id = ++lastId;
+        hasPending = true;
+        activeJob.store(pending.id, std::memory_order_relaxed);
+        signals.stop.store(true, std::memory_order_relaxed);
+        wake.notify_all();
+        return pending.id;
+    }
+
+    // La reflexion en cours (ponder) devient la vraie : echeance a partir de maintenant
+    void PonderHit(uint32_t job) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (job != activeJob.load(std::memory_order_relaxed)) return;
+        if (hasPending && pending.id == job) {
+            pending.limits.ponder = false; // Pas encore commencee
+            return;
+        }
+        ponderHit = true;
+        if (runningLimitMs > 0) signals.SetDeadline(SearchSignals::Clock::now() + std::chrono::milliseconds(runningLimitMs));
+        wake.notify_all();
+    }
+
+    // Abandonne tout : plus aucun message de la reflexion en cours
+    void Cancel() {
+        std::lock_guard<std::mutex> lock(mutex);
+        hasPending = false;
+        activeJob.store(0, std::memory_order_relaxed);
+        signals.stop.store(true, std::memory_order_relaxed);
+        wake.notify_all();
+    }
+
+    // Thread d'affichage seulement
+    bool Poll(AIMessage& out) { return messages.Pop(out); }
+
+private:
+    struct Job {
+        B root;
+        SearchLimits limits;
+        AIEngine engine;
+        uint32_t id;
+    };
+
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this]() { return quit || hasPending; });
+            if (quit) return;
+
+            Job job = pending;
+            hasPending = false;
+            ponderHit = !job.limits.ponder;
+            runningLimitMs = job.limits.timeLimitMs;
+            signals.stop.store(false, std::memory_order_relaxed);
+            signals.deadline.store(0, std::memory_order_relaxed);
+            lock.unlock();
+
+            AIMessage best = Execute(job);
+
+            // Ponder termine avant le coup de l'humain : le coup attend le PonderHit
+            lock.lock();
+            wake.wait(lock, [&]() { return quit || ponderHit || activeJob.load(std::memory_order_relaxed) != job.id; });
+            if (quit) return;
+            if (activeJob.load(std::memory_order_relaxed) != job.id) continue;
+            lock.unlock();
+
+            // Le consommateur vide la file a chaque image : elle n'est pleine qu'un instant
+            while (!messages.Push(best) && activeJob.load(std::memory_order_relaxed) == job.id) std::this_thread::yield();
+            lock.lock();
+        }
+    }
+
+    AIMessage Execute(const Job& job) {
+        AIMessage msg = AIMessage();
+        msg.type = AI_BEST_MOVE;
+        msg.job = job.id;
+        msg.engine = job.engine;
+
+        if (job.engine == ENGINE_MCTS) {
+            MctsLimits limits;
+            limits.timeLimitMs = job.limits.timeLimitMs;
+            limits.threads = 0;
+            limits.seed = HashPosition(job.root);
+            limits.stop = &signals.stop;
+            MctsResult r = MctsSearch(job.root, limits, arena);
+            msg.result.bestMove = r.bestMove;
+            msg.result.nodes = r.nodes;
+            msg.result.seconds = r.seconds;
+            msg.result.pvLength = r.pvLength < MAX_PLY ? r.pvLength : MAX_PLY;
+            for (int i = 0; i < msg.result.pvLength; i++) msg.result.pv[i] = r.pv[i];
+            msg.winRate = r.winRate;
+            msg.playouts = r.iterations;
+            return msg;
+        }
+
+        // PV provisoire a chaque iteration (perdue si la file est pleine : la suivante suivra)
+        signals.onIteration = [this, &job](const SearchResult& r) {
+            AIMessage info = AIMessage();
+            info.type = AI_INFO;
+            info.job = job.id;
+            info.engine = job.engine;
+            info.result = r;
+            messages.Push(info);
+        };
+        SearchLimits limits = job.limits;
+        limits.signals = &signals;
+        msg.result = SearchPosition(job.root, limits, &tt, &egtb);
+        signals.onIteration = nullptr;
+        return msg;
+    }
+
+    TranspositionTable& tt;
+    const EndgameTable& egtb;
+    MctsArena& arena;
+
+    SearchSignals signals;
+    SpscQueue<AIMessage, 64> messages;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    Job pending;
+    bool hasPending = false;
+    bool ponderHit = false;
+    bool quit = false;
+    int runningLimitMs = 0;
+    uint32_t lastId = 0;
+    std::atomic<uint32_t> activeJob{0}; // Seule reflexion dont les messages comptent encore
+
+    std::thread thread; // Lance dans le constructeur, une fois tous les membres prets
+};
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef ANALYSIS_HPP
+#define ANALYSIS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Board.hpp"
+#include "EndgameDb.hpp"
+#include "Search.hpp"
+#include "TranspositionTable.hpp"
+
+// Analyse en lot : un flux de positions (texte ou parties archivees) cherchees
+// chacune par un thread du groupe, les resultats rendus dans l'ordre d'arrivee.
+// Chaque thread a sa table de transposition ; une position n'occupe qu'un
+// thread, le parallelisme vient du nombre de positions.
+
+struct AnalysisConfig {
+    int depth = 12;       // Profondeur max
+    int timeMs = 0;       // Si > 0 : limite de temps par position
+    int threads = 0;      // 0 = tous les coeurs
+    int hashMb = 16;      // Table de transposition par thread
+    int window = 0;       // Positions d'avance permises sur la plus ancienne non rendue (0 = 64 par thread)
+};
+
+template <class B>
+struct AnalysisItem {
+    B position;
+    int played = -1;      // Coup joue ensuite dans la partie (-1 : position seule)
+    uint64_t game = 0;    // Partie (archive) ou ligne (texte) d'origine
+    int ply = 0;          // Demi-coup dans la partie
+};
+
+struct AnalysisStats {
+    uint64_t positions = 0;
+    uint64_t nodes = 0;
+    double seconds = 0.0;
+};
+
+// SearchPosition, mais un coup force est suivi : on veut aussi son score et sa PV.
+// Une issue prouvee n'a son ecart final exact (r.exact) que dans la base de
+// finales ou au bout d'une suite forcee ; sinon c'est l'ecart garanti au gagnant.
+template <class B>
+SearchResult AnalyzePosition(const B& b, const SearchLimits& limits, TranspositionTable* tt, const EndgameTable* egtb, int ply = 0) {
+    SearchResult r = SearchPosition(b, limits, tt, egtb);
+    if (r.pvLength == 0 && r.bestMove >= 0) { // Racine deja decidee : pas de PV, le coup seul
+        r.pv[0] = r.bestMove;
+        r.pvLength = 1;
+    }
+    if (r.depth > 0 || r.bestMove < 0 || ply + 1 >= MAX_PLY) return r;
+
+    B child = b;
+    ApplyMove(child, r.bestMove);
+    SearchResult next;
+    if (IsTerminal(child)) {
+        next.score = Evaluate(child, egtb);
+        next.exact = true;
+    } else {
+        next = AnalyzePosition(child, limits, tt, egtb, ply + 1);
+    }
+    r.score = child.sideToMove == b.sideToMove ? next.score : -next.score;
+    r.exact = next.exact;
+    r.depth = next.depth + 1;
+    r.nodes += next.nodes;
+    r.pvLength = next.pvLength + 1 < MAX_PLY ? next.pvLength + 1 : MAX_PLY;
+    for (int k = 1; k < r.pvLength; k++) r.pv[k] = next.pv[k - 1];
+    return r;
+}
+
+// 'source(item)' fournit la position suivante (false a la fin), appelee sous verrou.
+// 'sink(item, result)' recoit les resultats un par un dans l'ordre de la source,
+// sous verrou lui aussi : il peut ecrire directement sur la sortie.
+// Un thread trop en avance attend que les resultats plus anciens soient rendus :
+// la memoire reste bornee quelle que soit la longueur du flux.
+template <class B, class Source, class Sink>
+AnalysisStats AnalyzeStream(const AnalysisConfig& cfg, Source source, Sink sink, const EndgameTable* egtb = nullptr) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    int threadCount = cfg.threads > 0 ? cfg.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    uint64_t window = cfg.window > 0 ? (uint64_t)cfg.window : 64u * threadCount;
+
+    std::mutex mutex;
+    std::condition_variable progress;
+    uint64_t taken = 0;   // Positions distribuees
+    uint64_t emitted = 0; // Positions rendues a 'sink'
+    bool exhausted = false;
+    std::map<uint64_t, std::pair<AnalysisItem<B>, SearchResult>> finished; // Termines, en attente des precedents
+    AnalysisStats stats;
+
+    auto worker = [&]() {
+        std::unique_ptr<TranspositionTable> tt(new TranspositionTable(cfg.hashMb));
+        SearchLimits limits;
+        limits.maxDepth = cfg.depth;
+        limits.timeLimitMs = cfg.timeMs;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            progress.wait(lock, [&]() { return exhausted || taken < emitted + window; });
+            AnalysisItem<B> item;
+            if (exhausted || !source(item)) {
+                exhausted = true;
+                progress.notify_all();
+                return;
+            }
+            uint64_t index = taken++;
+            lock.unlock();
+
+            SearchResult r = AnalyzePosition(item.position, limits, tt.get(), egtb);
+
+            lock.lock();
+            stats.nodes += r.nodes;
+            finished.emplace(index, std::make_pair(item, r));
+            for (auto it = finished.begin(); it != finished.end() && it->first == emitted; it = finished.erase(it)) {
+                sink(it->second.first, it->second.second);
+                emitted++;
+            }
+            progress.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; t++) workers.emplace_back(worker);
+    worker();
+    for (auto& w : workers) w.join();
+
+    stats.positions = emitted;
+    stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return stats;
+}
+
+#endif
@@ -0,0 +1,304 @@
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include <cstdint>
+
+// Position compacte d'une variante de mancala, sans dependance GL/glm.
+// Numerotation (N = trous par camp), identique a MancalaGame :
+//   0..N-1     = trous du Joueur 1 (Bas),  N      = magasin J1
+//   N+1..2N    = trous du Joueur 2 (Haut), 2N + 1 = magasin J2
+// Pour le Kalah(6,4) : 0-5 = J1, 6 = magasin J1, 7-12 = J2, 13 = magasin J2
+
+// --- POLITIQUES DE REGLES ---
+enum CaptureRule {
+    CAPTURE_EMPTY_OWN_PIT, // Kalah : derniere graine dans un trou vide de son camp => prend le trou d'en face
+    CAPTURE_TWO_OR_THREE   // Oware : derniere graine chez l'adversaire qui fait 2 ou 3 => prend en remontant
+};
+
+struct KalahRules {
+    static constexpr bool SOW_OWN_STORE = true;  // Son magasin fait partie de l'anneau de distribution
+    static constexpr bool SKIP_ORIGIN   = false; // On reseme dans le trou de depart apres un tour complet
+    static constexpr bool EXTRA_TURN    = true;  // Derniere graine dans son magasin => rejoue
+    static constexpr bool MUST_FEED     = false; // Obligation de nourrir un adversaire affame
+    static constexpr CaptureRule CAPTURE = CAPTURE_EMPTY_OWN_PIT;
+};
+
+struct OwareRules {
+    static constexpr bool SOW_OWN_STORE = false;
+    static constexpr bool SKIP_ORIGIN   = true;
+    static constexpr bool EXTRA_TURN    = false;
+    static constexpr bool MUST_FEED     = true;
+    static constexpr CaptureRule CAPTURE = CAPTURE_TWO_OR_THREE; // Sans "grand chelem" (on ne vide pas tout le camp adverse)
+};
+
+// Resultat d'un coup (tout ce dont la vue a besoin pour ses messages)
+struct MoveResult {
+    int lastPit;           // Trou ou tombe la derniere graine
+    int captured;          // Graines capturees (0 si pas de capture)
+    uint32_t capturedPits; // Masque des trous vides par la capture
+    bool extraTurn;        // Derniere graine dans son magasin => rejoue
+    bool gameOver;         // Partie finie => ramassage final effectue
+    int swept[2];          // Graines ramassees par chaque camp a la fin (0 sinon)
+};
+
+// --- TABLES CALCULEES A LA COMPILATION ---
+template <int PitsPerSide, class RulePolicy>
+struct BoardTables {
+    static constexpr int NUM_PITS = 2 * PitsPerSide + 2;
+    static constexpr int RING     = RulePolicy::SOW_OWN_STORE ? NUM_PITS - 1 : NUM_PITS - 2;
+
+    int8_t ringPit[2][RING];       // k-ieme case de l'anneau de distribution du joueur
+    int8_t ringIndex[2][NUM_PITS]; // Position d'un trou dans l'anneau (-1 : saute)
+    int8_t opposite[NUM_PITS];     // Trou d'en face (-1 pour les magasins)
+    bool canCapture[2][NUM_PITS];  // Trous ou la derniere graine peut declencher une capture
+};
+
+template <int PitsPerSide, class RulePolicy>
+constexpr BoardTables<PitsPerSide, RulePolicy> MakeBoardTables() {
+    BoardTables<PitsPerSide, RulePolicy> t = {};
+    const int storeP1 = PitsPerSide;
+    const int storeP2 = 2 * PitsPerSide + 1;
+    for (int player = 0; player < 2; player++) {
+        int ownStore   = player == 0 ? storeP1 : storeP2;
+        int otherStore = player == 0 ? storeP2 : storeP1;
+        int k = 0;
+        for (int i = 0; i < t.NUM_PITS; i++) {
+            bool inRing = i != otherStore && (i != ownStore || RulePolicy::SOW_OWN_STORE);
+            t.ringIndex[player][i] = inRing ? k : -1;
+            if (inRing) t.ringPit[player][k++] = i;
+
+            bool own = player == 0 ? (i < storeP1) : (i > storeP1 && i < storeP2);
+            bool other = i != storeP1 && i != storeP2 && !own;
+            t.canCapture[player][i] = RulePolicy::CAPTURE == CAPTURE_EMPTY_OWN_PIT ? own : other;
+        }
+    }
+    for (int i = 0; i < t.NUM_PITS; i++) {
+        t.opposite[i] = (i == storeP1 || i == storeP2) ? -1 : 2 * PitsPerSide - i; // Formule symetrique
+    }
+    return t;
+}
+
+// --- PLATEAU ---
+template <int PitsPerSide, int SeedsPerPit, class RulePolicy>
+struct Board {
+    typedef RulePolicy Rules;
+    typedef BoardTables<PitsPerSide, RulePolicy> Tables;
+
+    static constexpr int PITS_PER_SIDE = PitsPerSide;
+    static constexpr int SEEDS_PER_PIT = SeedsPerPit;
+    static constexpr int NUM_PITS      = 2 * PitsPerSide + 2;
+    static constexpr int STORE_P1      = PitsPerSide;
+    static constexpr int STORE_P2      = 2 * PitsPerSide + 1;
+    static constexpr int TOTAL_SEEDS   = 2 * PitsPerSide * SeedsPerPit;
+    static constexpr int SOW_RING      = Tables::RING;                                       // Cases de l'anneau
+    static constexpr int SOW_LAP       = RulePolicy::SKIP_ORIGIN ? SOW_RING - 1 : SOW_RING; // Graines par tour complet
+    static constexpr Tables TABLES     = MakeBoardTables<PitsPerSide, RulePolicy>();
+
+    static_assert(TOTAL_SEEDS <= 255, "Les compteurs sont sur 8 bits");
+    static_assert(NUM_PITS <= 32, "MoveResult::capturedPits est un masque 32 bits");
+
+    uint8_t seeds[NUM_PITS]; // Nombre de graines par trou / magasin
+    uint8_t sideToMove;      // 0 = Bas, 1 = Haut
+
+    struct MoveList {
+        int moves[PitsPerSide];
+        int count;
+    };
+
+    // --- OUTILS D'INDEXATION ---
+    static constexpr int StoreOf(int player)    { return player == 0 ? STORE_P1 : STORE_P2; }
+    static constexpr int FirstPitOf(int player) { return player == 0 ? 0 : STORE_P1 + 1; }
+    static constexpr bool IsStore(int idx)      { return idx == STORE_P1 || idx == STORE_P2; }
+    static constexpr bool IsOwnPit(int player, int idx) {
+        return idx >= FirstPitOf(player) && idx < FirstPitOf(player) + PitsPerSide;
+    }
+    static constexpr int OppositePit(int idx)   { return TABLES.opposite[idx]; }
+
+    // Trou ou tombe la k-ieme graine (k >= 1) semee depuis 'origin'.
+    // Sert a l'animation pour reconstituer le chemin graine par graine.
+    static constexpr int SowTarget(int origin, int player, int k) {
+        return TABLES.ringPit[player][(TABLES.ringIndex[player][origin] + 1 + (k - 1) % SOW_LAP) % SOW_RING];
+    }
+
+    // Trou suivant pendant la distribution (on saute le magasin adverse)
+    static constexpr int NextSowPit(int idx, int player) {
+        return TABLES.ringPit[player][(TABLES.ringIndex[player][idx] + 1) % SOW_RING];
+    }
+
+    // Plateau de depart : SeedsPerPit graines partout, magasins vides, J1 commence
+    static Board Initial() {
+        Board b;
+        for (int i = 0; i < NUM_PITS; i++) b.seeds[i] = IsStore(i) ? 0 : SeedsPerPit;
+        b.sideToMove = 0;
+        return b;
+    }
+};
+
+typedef Board<6, 4, KalahRules> Kalah6x4; // Le jeu de la fenetre 3D
+typedef Board<6, 6, KalahRules> Kalah6x6;
+typedef Board<6, 4, OwareRules> Oware6x4;
+
+// --- FONCTIONS DE REGLES (pures, pour n'importe quelle variante) ---
+
+template <class B>
+inline int SideSeeds(const B& b, int player) {
+    int total = 0;
+    int first = B::FirstPitOf(player);
+    for (int i = first; i < first + B::PITS_PER_SIDE; i++) total += b.seeds[i];
+    return total;
+}
+
+// Oware : un coup qui n'envoie aucune graine a un adversaire affame est interdit
+template <class B>
+inline bool FeedsOpponent(const B& b, int pit) {
+    int player = b.sideToMove;
+    int distance = B::FirstPitOf(player) + B::PITS_PER_SIDE - pit; // Graines pour atteindre le camp adverse
+    return b.seeds[pit] >= distance || SideSeeds(b, 1 - player) > 0;
+}
+
+template <class B>
+inline bool IsLegalMove(const B& b, int pit) {
+    if (!B::IsOwnPit(b.sideToMove, pit) || b.seeds[pit] == 0) return false;
+    if (B::Rules::MUST_FEED) return FeedsOpponent(b, pit);
+    return true;
+}
+
+template <class B>
+inline typename B::MoveList LegalMoves(const B& b) {
+    typename B::MoveList list;
+    list.count = 0;
+    int first = B::FirstPitOf(b.sideToMove);
+    for (int i = first; i < first + B::PITS_PER_SIDE; i++) {
+        if (b.seeds[i] == 0) continue;
+        if (B::Rules::MUST_FEED && !FeedsOpponent(b, i)) continue;
+        list.moves[list.count++] = i;
+    }
+    return list;
+}
+
+// Kalah : fini des qu'un camp est vide.
+// Oware : fini quand un magasin a plus de la moitie des graines ou que le joueur au trait est bloque.
+template <class B>
+inline bool IsTerminal(const B& b) {
+    if (B::Rules::CAPTURE == CAPTURE_TWO_OR_THREE) {
+        if (2 * b.seeds[B::STORE_P1] > B::TOTAL_SEEDS || 2 * b.seeds[B::STORE_P2] > B::TOTAL_SEEDS) return true;
+        return LegalMoves(b).count == 0;
+    }
+    return SideSeeds(b, 0) == 0 || SideSeeds(b, 1) == 0;
+}
+
+// Fin de partie : chaque camp ramasse ce qui reste de son cote.
+// 'swept' (optionnel) recoit le nombre de graines ramassees par camp,
+// 'before' (optionnel) le contenu des 2 * PITS_PER_SIDE trous avant ramassage (J1 puis J2).
+template <class B>
+inline void SweepRemaining(B& b, int* swept = nullptr, uint8_t* before = nullptr) {
+    for (int player = 0; player < 2; player++) {
+        int first = B::FirstPitOf(player);
+        int total = 0;
+        for (int i = first; i < first + B::PITS_PER_SIDE; i++) {
+            if (before) before[player * B::PITS_PER_SIDE + i - first] = b.seeds[i];
+            total += b.seeds[i];
+            b.seeds[i] = 0;
+        }
+        b.seeds[B::StoreOf(player)] += total;
+        if (swept) swept[player] = total;
+    }
+}
+
+// 0 = J1 gagne, 1 = J2 gagne, -1 = egalite
+template <class B>
+inline int Winner(const B& b) {
+    if (b.seeds[B::STORE_P1] > b.seeds[B::STORE_P2]) return 0;
+    if (b.seeds[B::STORE_P2] > b.seeds[B::STORE_P1]) return 1;
+    return -1;
+}
+
+// Distribution seule, en O(trous) : tours complets puis reste. Renvoie le dernier trou.
+template <class B>
+inline int SowSeeds(B& b, int pit) {
+    int player = b.sideToMove;
+    int seedsInHand = b.seeds[pit];
+    b.seeds[pit] = 0;
+
+    int laps = seedsInHand / B::SOW_LAP;
+    int remainder = seedsInHand % B::SOW_LAP;
+    if (laps > 0) {
+        for (int k = 0; k < B::SOW_RING; k++) b.seeds[B::TABLES.ringPit[player][k]] += laps;
+        if (B::Rules::SKIP_ORIGIN) b.seeds[pit] -= laps;
+    }
+    int idx = pit;
+    for (int i = 0; i < remainder; i++) {
+        idx = B::NextSowPit(idx, player);
+        b.seeds[idx]++;
+    }
+    // Reste nul : la derniere graine est celle du dernier tour complet
+    return seedsInHand > 0 ? B::SowTarget(pit, player, seedsInHand) : pit;
+}
+
+// Suite d'un coup dont les graines sont deja semees (derniere dans 'idx') :
+// capture, rejoue, ramassage final. Partagee avec la distribution vectorielle (BoardSimd.hpp).
+// 'sweptPits' (optionnel) : voir SweepRemaining, pour pouvoir defaire le coup (MoveLog.hpp).
+template <class B>
+inline MoveResult ResolveMove(B& b, int idx, uint8_t* sweptPits = nullptr) {
+    MoveResult r;
+    r.captured = 0;
+    r.capturedPits = 0;
+    r.extraTurn = false;
+    r.swept[0] = r.swept[1] = 0;
+
+    int player = b.sideToMove;
+    r.lastPit = idx;
+
+    // REGLE : REJOUER si on finit dans son magasin
+    if (B::Rules::EXTRA_TURN && idx == B::StoreOf(player)) {
+        r.extraTurn = true;
+    }
+    // REGLE (Kalah) : CAPTURE si on finit dans un trou vide de son cote
+    else if (B::Rules::CAPTURE == CAPTURE_EMPTY_OWN_PIT) {
+        if (B::TABLES.canCapture[player][idx] && b.seeds[idx] == 1) {
+            int opposite = B::OppositePit(idx);
+            if (b.seeds[opposite] > 0) {
+                r.captured = b.seeds[opposite] + 1; // +1 pour celle qu'on vient de poser
+                r.capturedPits = (1u << idx) | (1u << opposite);
+                b.seeds[opposite] = 0;
+                b.seeds[idx] = 0;
+                b.seeds[B::StoreOf(player)] += r.captured;
+            }
+        }
+    }
+    // REGLE (Oware) : CAPTURE des trous adverses a 2 ou 3 graines, en remontant depuis le dernier
+    else if (B::TABLES.canCapture[player][idx]) {
+        int first = B::FirstPitOf(1 - player);
+        int taken = 0;
+        uint32_t mask = 0;
+        for (int i = idx; i >= first && (b.seeds[i] == 2 || b.seeds[i] == 3); i--) {
+            taken += b.seeds[i];
+            mask |= 1u << i;
+        }
+        // Pas de grand chelem : si on viderait tout le camp adverse, on ne prend rien
+        if (taken > 0 && taken < SideSeeds(b, 1 - player)) {
+            for (int i = first; i < first + B::PITS_PER_SIDE; i++) {
+                if (mask & (1u << i)) b.seeds[i] = 0;
+            }
+            b.seeds[B::StoreOf(player)] += taken;
+            r.captured = taken;
+            r.capturedPits = mask;
+        }
+    }
+
+    if (!r.extraTurn) b.sideToMove = 1 - player;
+    r.gameOver = IsTerminal(b);
+    if (r.gameOver) {
+        SweepRemaining(b, r.swept, sweptPits);
+        b.sideToMove = player; // Le trait reste a celui qui a joue le dernier coup
+    }
+    return r;
+}
+
+// Joue un coup legal : distribution, capture, rejoue, ramassage final
+template <class B>
+inline MoveResult ApplyMove(B& b, int pit) {
+    return ResolveMove(b, SowSeeds(b, pit));
+}
+
+#endif
@@ -0,0 +1,425 @@
+#ifndef BOARDSIMD_HPP
+#define BOARDSIMD_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "Board.hpp"
+#include "Rng.hpp"
+
+// Coups et evaluations par lots sur des plateaux de 16 octets.
+// Un plateau (14 compteurs + le trait) tient dans un registre SSE, deux dans
+// un registre AVX2 : la distribution devient trois operations vectorielles
+// (vider le trou de depart, ajouter les tours complets, ajouter le reste),
+// quel que soit le nombre de graines. Capture, rejoue et fin de partie restent
+// scalaires (ResolveMove) : les resultats sont identiques a ApplyMove.
+// Le jeu d'instructions est choisi a l'execution ; sans SSSE3 (ou hors x86,
+// ou hors GCC/Clang) tout passe par la version scalaire.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MANCALA_SIMD_X86 1
+#include <immintrin.h>
+#define MANCALA_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MANCALA_SIMD_X86 0
+#endif
+
+enum SimdLevel {
+    SIMD_SCALAR,
+    SIMD_SSSE3,  // Un plateau par registre
+    SIMD_AVX2    // Deux plateaux par registre
+};
+
+inline const char* SimdLevelName(SimdLevel level) {
+    switch (level) {
+    case SIMD_SSSE3: return "ssse3";
+    case SIMD_AVX2:  return "avx2";
+    default:         return "scalar";
+    }
+}
+
+inline bool ParseSimdLevel(const std::string& name, SimdLevel& out) {
+    if (name == "scalar") out = SIMD_SCALAR;
+    else if (name == "ssse3") out = SIMD_SSSE3;
+    else if (name == "avx2") out = SIMD_AVX2;
+    else return false;
+    return true;
+}
+
+// Meilleur niveau gere par le processeur
+inline SimdLevel DetectSimdLevel() {
+#if MANCALA_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("ssse3")) return SIMD_SSSE3;
+#endif
+    return SIMD_SCALAR;
+}
+
+inline std::atomic<int>& SimdLevelSetting() {
+    static std::atomic<int> level(DetectSimdLevel());
+    return level;
+}
+
+inline SimdLevel ActiveSimdLevel() {
+    return (SimdLevel)SimdLevelSetting().load(std::memory_order_relaxed);
+}
+
+// Force un niveau (comparaisons, mesures) ; refuse ce que le processeur ne sait pas faire
+inline bool SetSimdLevel(SimdLevel level) {
+    if (level > DetectSimdLevel()) return false;
+    SimdLevelSetting().store(level, std::memory_order_relaxed);
+    return true;
+}
+
+// --- PLATEAU SUR 16 OCTETS ---
+// Board<> est deja un tableau d'octets (trous puis trait) : on ne fait que l'aligner.
+template <class B>
+struct alignas(16) PackedBoard {
+    static_assert(sizeof(B) < 16, "Le plateau doit tenir dans 16 octets");
+    B board;
+    uint8_t padding[16 - sizeof(B)];
+};
+
+// Indicateurs d'evaluation, du point de vue du joueur au trait
+struct BoardFeatures {
+    int storeDiff;   // Son magasin - magasin adverse
+    int ownSeeds;    // Graines en jeu dans son camp
+    int otherSeeds;  // Graines en jeu dans le camp adverse
+    int captures;    // Kalah : coups (de moins d'un tour) qui capturent ; Oware : trous adverses a 1 ou 2 graines
+};
+
+// --- TABLES CALCULEES A LA COMPILATION ---
+template <class B>
+struct SimdTables {
+    uint8_t keep[B::NUM_PITS][16];                      // 0xFF partout sauf sur le trou de depart
+    uint8_t lap[2][B::NUM_PITS][16];                    // 0xFF sur les cases servies a chaque tour complet
+    uint8_t partial[2][B::NUM_PITS][B::SOW_LAP][16];    // 1 sur les 'reste' cases qui suivent le depart
+    uint8_t sides[2][16];                               // pshufb : son camp en 0..N-1, camp adverse en 8..8+N-1
+    uint8_t own[2][16];                                 // pshufb : son camp en 0..N-1
+    uint8_t facing[2][16];                              // pshufb : trou d'en face de chacun des siens en 0..N-1
+    uint8_t shift[B::PITS_PER_SIDE][16];                // pshufb : octet i <- octet i + k (zero au-dela)
+};
+
+template <class B>
+constexpr SimdTables<B> MakeSimdTables() {
+    SimdTables<B> t = {};
+    const int N = B::PITS_PER_SIDE;
+    for (int pit = 0; pit < B::NUM_PITS; pit++) {
+        for (int i = 0; i < 16; i++) t.keep[pit][i] = i == pit ? 0x00 : 0xFF;
+    }
+    for (int player = 0; player < 2; player++) {
+        for (int pit = 0; pit < B::NUM_PITS; pit++) {
+            for (int k = 0; k < B::SOW_RING; k++) {
+                int target = B::TABLES.ringPit[player][k];
+                if (!(B::Rules::SKIP_ORIGIN && target == pit)) t.lap[player][pit][target] = 0xFF;
+            }
+            if (B::TABLES.ringIndex[player][pit] < 0) continue; // Magasin adverse : jamais un depart
+            for (int rem = 0; rem < B::SOW_LAP; rem++) {
+                for (int k = 1; k <= rem; k++) {
+                    t.partial[player][pit][rem][B::TABLES.ringPit[player][(B::TABLES.ringIndex[player][pit] + k) % B::SOW_RING]] = 1;
+                }
+            }
+        }
+        for (int i = 0; i < 16; i++) { t.sides[player][i] = 0x80; t.own[player][i] = 0x80; t.facing[player][i] = 0x80; }
+        for (int i = 0; i < N; i++) {
+            t.sides[player][i] = (uint8_t)(B::FirstPitOf(player) + i);
+            t.sides[player][8 + i] = (uint8_t)(B::FirstPitOf(1 - player) + i);
+            t.own[player][i] = (uint8_t)(B::FirstPitOf(player) + i);
+            t.facing[player][i] = (uint8_t)B::OppositePit(B::FirstPitOf(player) + i);
+        }
+    }
+    for (int k = 0; k < N; k++) {
+        for (int i = 0; i < 16; i++) t.shift[k][i] = i + k < 16 ? (uint8_t)(i + k) : 0x80;
+    }
+    return t;
+}
+
+template <class B>
+struct SimdTablesOf {
+    static constexpr SimdTables<B> TABLES = MakeSimdTables<B>();
+};
+
+// --- VERSION SCALAIRE (reference et repli) ---
+template <class B>
+inline BoardFeatures ComputeFeatures(const B& b) {
+    BoardFeatures f;
+    int me = b.sideToMove;
+    f.storeDiff = b.seeds[B::StoreOf(me)] - b.seeds[B::StoreOf(1 - me)];
+    f.ownSeeds = SideSeeds(b, me);
+    f.otherSeeds = SideSeeds(b, 1 - me);
+    f.captures = 0;
+    if (B::Rules::CAPTURE == CAPTURE_EMPTY_OWN_PIT) {
+        int first = B::FirstPitOf(me);
+        for (int i = 0; i < B::PITS_PER_SIDE; i++) {
+            int s = b.seeds[first + i];
+            if (s == 0 || i + s >= B::PITS_PER_SIDE) continue;
+            int target = first + i + s;
+            if (b.seeds[target] == 0 && b.seeds[B::OppositePit(target)] > 0) f.captures++;
+        }
+    } else {
+        int first = B::FirstPitOf(1 - me);
+        for (int i = first; i < first + B::PITS_PER_SIDE; i++) {
+            if (b.seeds[i] == 1 || b.seeds[i] == 2) f.captures++;
+        }
+    }
+    return f;
+}
+
+template <class B>
+inline void ApplyMovesScalar(PackedBoard<B>* boards, const uint8_t* moves, int count, MoveResult* results) {
+    for (int i = 0; i < count; i++) {
+        MoveResult r = ApplyMove(boards[i].board, moves[i]);
+        if (results) results[i] = r;
+    }
+}
+
+template <class B>
+inline void EvaluateScalar(const PackedBoard<B>* boards, int count, BoardFeatures* out) {
+    for (int i = 0; i < count; i++) out[i] = ComputeFeatures(boards[i].board);
+}
+
+#if MANCALA_SIMD_X86
+// --- SSSE3 : un plateau par registre ---
+template <class B>
+MANCALA_TARGET("ssse3") inline int SowPackedSsse3(PackedBoard<B>& p, int pit) {
+    const SimdTables<B>& t = SimdTablesOf<B>::TABLES;
+    int player = p.board.sideToMove;
+    int s = p.board.seeds[pit];
+    int laps = s / B::SOW_LAP;
+    int rem = s % B::SOW_LAP;
+    __m128i v = _mm_load_si128((const __m128i*)&p);
+    v = _mm_and_si128(v, _mm_loadu_si128((const __m128i*)t.keep[pit]));
+    v = _mm_add_epi8(v, _mm_and_si128(_mm_loadu_si128((const __m128i*)t.lap[player][pit]), _mm_set1_epi8((char)laps)));
+    v = _mm_add_epi8(v, _mm_loadu_si128((const __m128i*)t.partial[player][pit][rem]));
+    _mm_store_si128((__m128i*)&p, v);
+    return s > 0 ? B::SowTarget(pit, player, s) : pit;
+}
+
+template <class B>
+MANCALA_TARGET("ssse3") inline void ApplyMovesSsse3(PackedBoard<B>* boards, const uint8_t* moves, int count, MoveResult* results) {
+    for (int i = 0; i < count; i++) {
+        MoveResult r = ResolveMove(boards[i].board, SowPackedSsse3(boards[i], moves[i]));
+        if (results) results[i] = r;
+    }
+}
+
+// Masque des trous d'ou un coup de moins d'un tour finit dans un trou vide a soi, en face d'un trou plein
+template <class B>
+MANCALA_TARGET("ssse3") inline __m128i CaptureMaskSsse3(__m128i own, __m128i facing) {
+    const SimdTables<B>& t = SimdTablesOf<B>::TABLES;
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    for (int k = 1; k < B::PITS_PER_SIDE; k++) {
+        __m128i shift = _mm_loadu_si128((const __m128i*)t.shift[k]);
+        __m128i landsEmpty = _mm_cmpeq_epi8(_mm_shuffle_epi8(own, shift), zero);
+        __m128i facingFull = _mm_cmpgt_epi8(_mm_shuffle_epi8(facing, shift), zero); // Zeros entrants : jamais vrai hors du camp
+        __m128i hasK = _mm_cmpeq_epi8(own, _mm_set1_epi8((char)k));
+        acc = _mm_or_si128(acc, _mm_and_si128(hasK, _mm_and_si128(landsEmpty, facingFull)));
+    }
+    return acc;
+}
+
+template <class B>
+MANCALA_TARGET("ssse3") inline void EvaluateSsse3(const PackedBoard<B>* boards, int count, BoardFeatures* out) {
+    const SimdTables<B>& t = SimdTablesOf<B>::TABLES;
+    const __m128i zero = _mm_setzero_si128();
+    const int sideMask = (1 << B::PITS_PER_SIDE) - 1;
+    for (int i = 0; i < count; i++) {
+        const B& b = boards[i].board;
+        int me = b.sideToMove;
+        __m128i v = _mm_load_si128((const __m128i*)&boards[i]);
+        __m128i sides = _mm_shuffle_epi8(v, _mm_loadu_si128((const __m128i*)t.sides[me]));
+        __m128i sums = _mm_sad_epu8(sides, zero); // Une somme par moitie : son camp, le camp adverse
+
+        BoardFeatures& f = out[i];
+        f.storeDiff = b.seeds[B::StoreOf(me)] - b.seeds[B::StoreOf(1 - me)];
+        f.ownSeeds = _mm_cvtsi128_si32(sums);
+        f.otherSeeds = _mm_extract_epi16(sums, 4);
+        if (B::Rules::CAPTURE == CAPTURE_EMPTY_OWN_PIT) {
+            __m128i own = _mm_shuffle_epi8(v, _mm_loadu_si128((const __m128i*)t.own[me]));
+            __m128i facing = _mm_shuffle_epi8(v, _mm_loadu_si128((const __m128i*)t.facing[me]));
+            f.captures = __builtin_popcount(_mm_movemask_epi8(CaptureMaskSsse3<B>(own, facing)) & sideMask);
+        } else {
+            __m128i weak = _mm_or_si128(_mm_cmpeq_epi8(sides, _mm_set1_epi8(1)), _mm_cmpeq_epi8(sides, _mm_set1_epi8(2)));
+            f.captures = __builtin_popcount((_mm_movemask_epi8(weak) >> 8) & sideMask);
+        }
+    }
+}
+
+// --- AVX2 : deux plateaux par registre (chaque moitie de 128 bits est un plateau) ---
+MANCALA_TARGET("avx2") inline __m256i LoadPairAvx2(const uint8_t* low, const uint8_t* high) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)low)),
+                                   _mm_loadu_si128((const __m128i*)high), 1);
+}
+
+template <class B>
+MANCALA_TARGET("avx2") inline void SowPairAvx2(PackedBoard<B>* p, const uint8_t* moves, int last[2]) {
+    const SimdTables<B>& t = SimdTablesOf<B>::TABLES;
+    int pit[2], player[2], s[2], rem[2];
+    __m128i laps[2];
+    for (int j = 0; j < 2; j++) {
+        pit[j] = moves[j];
+        player[j] = p[j].board.sideToMove;
+        s[j] = p[j].board.seeds[pit[j]];
+        rem[j] = s[j] % B::SOW_LAP;
+        laps[j] = _mm_set1_epi8((char)(s[j] / B::SOW_LAP));
+        last[j] = s[j] > 0 ? B::SowTarget(pit[j], player[j], s[j]) : pit[j];
+    }
+    __m256i v = _mm256_loadu_si256((const __m256i*)p);
+    v = _mm256_and_si256(v, LoadPairAvx2(t.keep[pit[0]], t.keep[pit[1]]));
+    __m256i lapCount = _mm256_inserti128_si256(_mm256_castsi128_si256(laps[0]), laps[1], 1);
+    v = _mm256_add_epi8(v, _mm256_and_si256(LoadPairAvx2(t.lap[player[0]][pit[0]], t.lap[player[1]][pit[1]]), lapCount));
+    v = _mm256_add_epi8(v, LoadPairAvx2(t.partial[player[0]][pit[0]][rem[0]], t.partial[player[1]][pit[1]][rem[1]]));
+    _mm256_storeu_si256((__m256i*)p, v); // Paires alignees sur 16 octets seulement
+}
+
+template <class B>
+MANCALA_TARGET("avx2") inline void ApplyMovesAvx2(PackedBoard<B>* boards, const uint8_t* moves, int count, MoveResult* results) {
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        int last[2];
+        SowPairAvx2(boards + i, moves + i, last);
+        for (int j = 0; j < 2; j++) {
+            MoveResult r = ResolveMove(boards[i + j].board, last[j]);
+            if (results) results[i + j] = r;
+        }
+    }
+    if (i < count) ApplyMovesSsse3(boards + i, moves + i, count - i, results ? results + i : nullptr);
+}
+
+template <class B>
+MANCALA_TARGET("avx2") inline void EvaluateAvx2(const PackedBoard<B>* boards, int count, BoardFeatures* out) {
+    const SimdTables<B>& t = SimdTablesOf<B>::TABLES;
+    const __m256i zero = _mm256_setzero_si256();
+    const int sideMask = (1 << B::PITS_PER_SIDE) - 1;
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        int me0 = boards[i].board.sideToMove, me1 = boards[i + 1].board.sideToMove;
+        __m256i v = _mm256_loadu_si256((const __m256i*)&boards[i]);
+        __m256i sides = _mm256_shuffle_epi8(v, LoadPairAvx2(t.sides[me0], t.sides[me1]));
+        __m256i sums = _mm256_sad_epu8(sides, zero); // [son camp, camp adverse] pour chaque plateau
+
+        int mask;
+        if (B::Rules::CAPTURE == CAPTURE_EMPTY_OWN_PIT) {
+            __m256i own = _mm256_shuffle_epi8(v, LoadPairAvx2(t.own[me0], t.own[me1]));
+            __m256i facing = _mm256_shuffle_epi8(v, LoadPairAvx2(t.facing[me0], t.facing[me1]));
+            __m256i acc = zero;
+            for (int k = 1; k < B::PITS_PER_SIDE; k++) {
+                __m256i shift = LoadPairAvx2(t.shift[k], t.shift[k]);
+                __m256i landsEmpty = _mm256_cmpeq_epi8(_mm256_shuffle_epi8(own, shift), zero);
+                __m256i facingFull = _mm256_cmpgt_epi8(_mm256_shuffle_epi8(facing, shift), zero);
+                __m256i hasK = _mm256_cmpeq_epi8(own, _mm256_set1_epi8((char)k));
+                acc = _mm256_or_si256(acc, _mm256_and_si256(hasK, _mm256_and_si256(landsEmpty, facingFull)));
+            }
+            mask = _mm256_movemask_epi8(acc);
+        } else {
+            __m256i weak = _mm256_or_si256(_mm256_cmpeq_epi8(sides, _mm256_set1_epi8(1)), _mm256_cmpeq_epi8(sides, _mm256_set1_epi8(2)));
+            mask = _mm256_movemask_epi8(weak) >> 8; // Camp adverse : octets 8.. de chaque moitie
+        }
+
+        for (int j = 0; j < 2; j++) {
+            const B& b = boards[i + j].board;
+            int me = b.sideToMove;
+            BoardFeatures& f = out[i + j];
+            f.storeDiff = b.seeds[B::StoreOf(me)] - b.seeds[B::StoreOf(1 - me)];
+            f.ownSeeds = _mm256_extract_epi16(sums, 0);
+            f.otherSeeds = _mm256_extract_epi16(sums, 4);
+            f.captures = __builtin_popcount(mask & sideMask);
+            sums = _mm256_permute4x64_epi64(sums, 0x0E); // Plateau suivant dans la moitie basse
+            mask = (int)((unsigned)mask >> 16);
+        }
+    }
+    if (i < count) EvaluateSsse3(boards + i, count - i, out + i);
+}
+#endif
+
+// --- POINTS D'ENTREE (niveau choisi a l'execution) ---
+
+// Joue moves[i] sur boards[i] pour tout i ; 'results' (optionnel) recoit les MoveResult
+template <class B>
+inline void ApplyMovesBatch(PackedBoard<B>* boards, const uint8_t* moves, int count, MoveResult* results = nullptr,
+                            SimdLevel level = ActiveSimdLevel()) {
+#if MANCALA_SIMD_X86
+    if (level == SIMD_AVX2) { ApplyMovesAvx2(boards, moves, count, results); return; }
+    if (level == SIMD_SSSE3) { ApplyMovesSsse3(boards, moves, count, results); return; }
+#endif
+    (void)level;
+    ApplyMovesScalar(boards, moves, count, results);
+}
+
+template <class B>
+inline void EvaluateBatch(const PackedBoard<B>* boards, int count, BoardFeatures* out, SimdLevel level = ActiveSimdLevel()) {
+#if MANCALA_SIMD_X86
+    if (level == SIMD_AVX2) { EvaluateAvx2(boards, count, out); return; }
+    if (level == SIMD_SSSE3) { EvaluateSsse3(boards, count, out); return; }
+#endif
+    (void)level;
+    EvaluateScalar(boards, count, out);
+}
+
+// --- PARTIES ALEATOIRES PAR LOTS ---
+struct PlayoutOutcome {
+    int8_t winner;    // 0, 1 ou -1 (egalite)
+    bool truncated;   // Arretee par maxPlies (puis ramassee)
+    int plies;
+};
+
+const int PLAYOUT_BATCH = 32;
+
+// 'count' parties aleatoires depuis 'start', menees de front : a chaque
+// demi-coup un coup tire pour chaque partie en cours, puis un seul lot
+// vectoriel pour tous. Les parties finies sortent du lot.
+template <class B>
+void BatchPlayouts(const B& start, int count, Rng& rng, int maxPlies, PlayoutOutcome* out,
+                   SimdLevel level = ActiveSimdLevel()) {
+    PackedBoard<B> boards[PLAYOUT_BATCH];
+    int game[PLAYOUT_BATCH];
+    uint8_t moves[PLAYOUT_BATCH];
+    MoveResult results[PLAYOUT_BATCH];
+
+    for (int first = 0; first < count; first += PLAYOUT_BATCH) {
+        int live = count - first < PLAYOUT_BATCH ? count - first : PLAYOUT_BATCH;
+        for (int j = 0; j < live; j++) {
+            boards[j].board = start;
+            game[j] = first + j;
+        }
+        if (IsTerminal(start)) live = 0;
+        for (int j = 0; j < count - first && j < PLAYOUT_BATCH; j++) {
+            out[first + j].winner = (int8_t)Winner(start);
+            out[first + j].truncated = false;
+            out[first + j].plies = 0;
+        }
+
+        for (int ply = 0; live > 0; ply++) {
+            if (ply >= maxPlies) {
+                for (int j = 0; j < live; j++) {
+                    SweepRemaining(boards[j].board);
+                    out[game[j]].winner = (int8_t)Winner(boards[j].board);
+                    out[game[j]].truncated = true;
+                    out[game[j]].plies = ply;
+                }
+                break;
+            }
+            for (int j = 0; j < live; j++) {
+                typename B::MoveList list = LegalMoves(boards[j].board);
+                moves[j] = (uint8_t)list.moves[rng.Below(list.count)];
+            }
+            ApplyMovesBatch(boards, moves, live, results, level);
+            for (int j = 0; j < live; j++) {
+                if (!results[j].gameOver) continue;
+                out[game[j]].winner = (int8_t)Winner(boards[j].board);
+                out[game[j]].plies = ply + 1;
+                // La derniere partie du lot prend la place libre
+                live--;
+                boards[j] = boards[live];
+                game[j] = game[live];
+                results[j] = results[live];
+                j--;
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef ENDGAMEDB_HPP
+#define ENDGAMEDB_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Board.hpp"
+#include "MappedFile.hpp"
+
+// Base de finales (regles du Kalah) : pour chaque repartition d'au plus K
+// graines sur les 2N trous (magasins exclus), l'ecart exact que le joueur au
+// trait obtiendra sur les graines encore en jeu, les deux camps jouant parfaitement.
+// Au Kalah les magasins ne changent rien a la suite :
+//   ecart final = (magasin du joueur au trait - magasin adverse) + valeur.
+// La base ne depend que du nombre de trous par camp : Kalah(6,4) et Kalah(6,6) partagent la meme.
+
+// --- FORMAT DU FICHIER (petit-boutiste) ---
+//   EndgameHeader (32 octets) puis entryCount valeurs int8, une par rang
+struct EndgameHeader {
+    char magic[8];        // "MNCLEGDB"
+    uint32_t version;
+    uint32_t pitsPerSide;
+    uint32_t maxSeeds;    // K
+    uint32_t reserved;
+    uint64_t entryCount;  // Nombre de repartitions de 0..K graines
+};
+static_assert(sizeof(EndgameHeader) == 32, "En-tete de base de finales sur 32 octets");
+
+const char ENDGAME_MAGIC[8] = {'M', 'N', 'C', 'L', 'E', 'G', 'D', 'B'};
+const uint32_t ENDGAME_VERSION = 1;
+
+// --- RANG PARFAIT ---
+// Repartitions classees par nombre total de graines, puis dans l'ordre
+// lexicographique des trous : rang dense dans [0, Count()), sans trou ni collision.
+class EndgameIndex {
+public:
+    void Init(int pitCount, int maxSeeds) {
+        m = pitCount;
+        k = maxSeeds;
+        int n = k + m;
+        binom.assign((size_t)(n + 1) * (m + 1), 0);
+        for (int i = 0; i <= n; i++) {
+            binom[(size_t)i * (m + 1)] = 1;
+            for (int j = 1; j <= m && j <= i; j++) binom[(size_t)i * (m + 1) + j] = C(i - 1, j - 1) + C(i - 1, j);
+        }
+    }
+
+    uint64_t Count() const { return C(k + m, m); }
+
+    // 'c' : les m trous (camp du joueur au trait d'abord), 'seeds' : leur somme
+    uint64_t Rank(const uint8_t* c, int seeds) const {
+        uint64_t r = C(seeds - 1 + m, m); // Repartitions de moins de 'seeds' graines
+        int remaining = seeds;
+        for (int i = 0; i < m - 1; i++) {
+            int rest = m - 1 - i;
+            // Repartitions dont le trou i a moins de c[i] graines (somme en crosse de hockey)
+            r += C(remaining + rest, rest) - C(remaining - c[i] + rest, rest);
+            remaining -= c[i];
+        }
+        return r;
+    }
+
+private:
+    uint64_t C(int n, int r) const {
+        if (n < 0 || r < 0 || r > n) return 0;
+        return binom[(size_t)n * (m + 1) + r];
+    }
+
+    int m = 0;
+    int k = 0;
+    std::vector<uint64_t> binom;
+};
+
+// Trous vus du joueur au trait : son camp puis le camp adverse. Renvoie la somme.
+template <class B>
+inline int CanonicalPits(const B& b, uint8_t out[]) {
+    int me = b.sideToMove, total = 0;
+    for (int i = 0; i < B::PITS_PER_SIDE; i++) {
+        out[i] = b.seeds[B::FirstPitOf(me) + i];
+        out[B::PITS_PER_SIDE + i] = b.seeds[B::FirstPitOf(1 - me) + i];
+        total += out[i] + out[B::PITS_PER_SIDE + i];
+    }
+    return total;
+}
+
+// --- LECTURE (fichier projete en memoire) ---
+class EndgameTable {
+public:
+    bool Open(const std::string& path) {
+        Close();
+        if (!file.Open(path)) {
+            std::cerr << "Base de finales introuvable : " << path << std::endl;
+            return false;
+        }
+        if (file.Size() < sizeof(EndgameHeader)) return Fail(path, "fichier trop court");
+        std::memcpy(&header, file.Data(), sizeof(header));
+        if (std::memcmp(header.magic, ENDGAME_MAGIC, 8) != 0) return Fail(path, "signature inconnue");
+        if (header.version != ENDGAME_VERSION) return Fail(path, "version non geree");
+
+        index.Init(2 * header.pitsPerSide, header.maxSeeds);
+        if (header.entryCount != index.Count() || file.Size() < sizeof(header) + header.entryCount) {
+            return Fail(path, "taille incoherente");
+        }
+        values = (const int8_t*)(file.Data() + sizeof(header));
+        return true;
+    }
+
+    void Close() {
+        file.Close();
+        values = nullptr;
+    }
+
+    bool IsOpen() const { return values != nullptr; }
+    int PitsPerSide() const { return (int)header.pitsPerSide; }
+    int MaxSeeds() const { return (int)header.maxSeeds; }
+    const EndgameIndex& Index() const { return index; }
+    int ValueAt(uint64_t rank) const { return values[rank]; }
+
+private:
+    bool Fail(const std::string& path, const char* why) {
+        std::cerr << "Base de finales invalide (" << why << ") : " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    MappedFile file;
+    EndgameHeader header = {};
+    EndgameIndex index;
+    const int8_t* values = nullptr;
+};
+
+// Valeur de la base pour 'b' (ecart sur les graines en jeu, vu du joueur au trait)
+template <class B>
+inline bool ProbeEndgame(const EndgameTable& t, const B& b, int& value) {
+    if (B::Rules::CAPTURE != CAPTURE_EMPTY_OWN_PIT) return false; // Kalah seulement
+    if (!t.IsOpen() || t.PitsPerSide() != B::PITS_PER_SIDE) return false;
+    if (B::TOTAL_SEEDS - b.seeds[B::STORE_P1] - b.seeds[B::STORE_P2] > t.MaxSeeds()) return false;
+
+    uint8_t c[2 * B::PITS_PER_SIDE];
+    int seeds = CanonicalPits(b, c);
+    value = t.ValueAt(t.Index().Rank(c, seeds));
+    return true;
+}
+
+// Ecart final des magasins en jeu parfait, vu du joueur au trait
+template <class B>
+inline bool ProbeFinalMargin(const EndgameTable& t, const B& b, int& margin) {
+    int value;
+    if (!ProbeEndgame(t, b, value)) return false;
+    int me = b.sideToMove;
+    margin = b.seeds[B::StoreOf(me)] - b.seeds[B::StoreOf(1 - me)] + value;
+    return true;
+}
+
+// --- GENERATION (outil hors ligne) ---
+// Le nombre de graines en jeu ne remonte jamais, et a nombre egal chaque coup
+// rapproche strictement les graines du joueur de son magasin : le graphe des
+// positions est sans cycle. On resout donc couche par couche (0, 1, ..., K
+// graines), chaque position ne dependant que de couches deja resolues ou de
+// positions plus "avancees" de sa propre couche (memorisees a la volee).
+template <class B>
+class EndgameBuilder {
+public:
+    static constexpr int8_t UNKNOWN = -128;
+    static constexpr int M = 2 * B::PITS_PER_SIDE;
+
+    bool Build(int maxSeeds) {
+        if (B::Rules::CAPTURE != CAPTURE_EMPTY_OWN_PIT) {
+            std::cerr << "Base de finales : seules les regles du Kalah sont gerees (l'Oware peut boucler)" << std::endl;
+            return false;
+        }
+        if (maxSeeds < 0 || maxSeeds > 127) {
+            std::cerr << "Base de finales : K doit etre entre 0 et 127" << std::endl;
+            return false;
+        }
+        k = maxSeeds;
+        index.Init(M, k);
+        values.assign(index.Count(), UNKNOWN);
+
+        uint8_t c[M];
+        for (int seeds = 0; seeds <= k; seeds++) Enumerate(c, 0, seeds, seeds);
+        return true;
+    }
+
+    bool Write(const std::string& path) const {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out) { std::cerr << "Impossible d'ecrire " << path << std::endl; return false; }
+        EndgameHeader h = {};
+        std::memcpy(h.magic, ENDGAME_MAGIC, 8);
+        h.version = ENDGAME_VERSION;
+        h.pitsPerSide = B::PITS_PER_SIDE;
+        h.maxSeeds = k;
+        h.entryCount = values.size();
+        out.write((const char*)&h, sizeof(h));
+        out.write((const char*)values.data(), (std::streamsize)values.size());
+        return (bool)out;
+    }
+
+    uint64_t Count() const { return values.size(); }
+    int ValueAt(uint64_t rank) const { return values[rank]; }
+
+private:
+    void Enumerate(uint8_t* c, int pos, int remaining, int seeds) {
+        if (pos == M - 1) {
+            c[pos] = (uint8_t)remaining;
+            Solve(c, seeds);
+            return;
+        }
+        for (int v = 0; v <= remaining; v++) {
+            c[pos] = (uint8_t)v;
+            Enumerate(c, pos + 1, remaining - v, seeds);
+        }
+    }
+
+    int Solve(const uint8_t* c, int seeds) {
+        uint64_t rank = index.Rank(c, seeds);
+        if (values[rank] != UNKNOWN) return values[rank];
+
+        // Position canonique : J1 au trait, magasins vides
+        B b;
+        for (int i = 0; i < B::NUM_PITS; i++) b.seeds[i] = 0;
+        int mySide = 0, otherSide = 0;
+        for (int i = 0; i < B::PITS_PER_SIDE; i++) {
+            b.seeds[i] = c[i];
+            b.seeds[B::STORE_P1 + 1 + i] = c[B::PITS_PER_SIDE + i];
+            mySide += c[i];
+            otherSide += c[B::PITS_PER_SIDE + i];
+        }
+        b.sideToMove = 0;
+
+        int best;
+        if (IsTerminal(b)) {
+            best = mySide - otherSide; // Chacun ramasse son camp
+        } else {
+            best = -128;
+            typename B::MoveList moves = LegalMoves(b);
+            for (int i = 0; i < moves.count; i++) {
+                B child = b;
+                MoveResult r = ApplyMove(child, moves.moves[i]);
+                int score = child.seeds[B::STORE_P1] - child.seeds[B::STORE_P2];
+                if (!r.gameOver) {
+                    uint8_t cc[M];
+                    int childSeeds = CanonicalPits(child, cc);
+                    int v = Solve(cc, childSeeds);
+                    score += child.sideToMove == 0 ? v : -v;
+                }
+                if (score > best) best = score;
+            }
+        }
+        values[rank] = (int8_t)best;
+        return best;
+    }
+
+    int k = 0;
+    EndgameIndex index;
+    std::vector<int8_t> values;
+};
+
+#endif
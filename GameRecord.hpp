@@ -0,0 +1,290 @@
+#ifndef GAMERECORD_HPP
+#define GAMERECORD_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Board.hpp"
+#include "MappedFile.hpp"
+
+// Archive de parties : un fichier par variante, les parties mises bout a bout,
+// un octet par coup. On l'ecrit en ajoutant a la fin (jeu 3D, auto-jeu) et on
+// le relit projete en memoire, partie apres partie, sans rien charger d'autre
+// que les pages parcourues : des dizaines de millions de parties se lisent
+// en un seul passage.
+
+// --- FORMAT DU FICHIER (petit-boutiste) ---
+//   RecordFileHeader (32 octets), puis pour chaque partie :
+//   GameRecordHeader (16 octets) suivi de moveCount octets, un par coup :
+//   l'indice du trou joue (le camp qui joue s'en deduit, 0..N-1 = J1).
+struct RecordFileHeader {
+    char magic[8];        // "MNCLGAME"
+    uint32_t version;
+    uint32_t pitsPerSide; // Variante de toutes les parties du fichier
+    uint32_t seedsPerPit;
+    uint32_t rules;       // CaptureRule de la variante
+    uint64_t reserved;
+};
+static_assert(sizeof(RecordFileHeader) == 32, "En-tete d'archive sur 32 octets");
+
+enum RecordPlayer : uint8_t {
+    PLAYER_HUMAN,
+    PLAYER_RANDOM,
+    PLAYER_GREEDY,
+    PLAYER_ALPHABETA,
+    PLAYER_MCTS
+};
+
+enum RecordResult : uint8_t {
+    RESULT_P1_WINS,
+    RESULT_P2_WINS,
+    RESULT_DRAW,
+    RESULT_UNFINISHED // Partie abandonnee (fenetre fermee...)
+};
+
+enum RecordFlags : uint8_t {
+    RECORD_P1_TIMED  = 1, // levels[0] est un temps par coup en ms
+    RECORD_P2_TIMED  = 2,
+    RECORD_TRUNCATED = 4  // Arretee par un garde-fou puis ramassee (Oware qui boucle)
+};
+
+#pragma pack(push, 1)
+struct GameRecordHeader {
+    uint16_t moveCount;
+    uint8_t result;      // RecordResult
+    uint8_t flags;       // RecordFlags
+    uint8_t players[2];  // RecordPlayer du J1 et du J2
+    uint8_t stores[2];   // Magasins a la fin de la partie
+    uint32_t levels[2];  // Force : profondeur, playouts ou ms par coup (0 = sans objet)
+};
+#pragma pack(pop)
+static_assert(sizeof(GameRecordHeader) == 16, "En-tete de partie sur 16 octets");
+
+const char RECORD_MAGIC[8] = {'M', 'N', 'C', 'L', 'G', 'A', 'M', 'E'};
+const uint32_t RECORD_VERSION = 1;
+const int RECORD_MAX_MOVES = 65535;
+
+template <class B>
+RecordFileHeader MakeRecordFileHeader() {
+    RecordFileHeader h = {};
+    std::memcpy(h.magic, RECORD_MAGIC, 8);
+    h.version = RECORD_VERSION;
+    h.pitsPerSide = B::PITS_PER_SIDE;
+    h.seedsPerPit = B::SEEDS_PER_PIT;
+    h.rules = (uint32_t)B::Rules::CAPTURE;
+    return h;
+}
+
+// En-tete d'une partie jouee jusqu'a 'final' (players et levels restent a remplir)
+template <class B>
+GameRecordHeader MakeGameRecordHeader(const B& final, int moveCount, bool finished) {
+    GameRecordHeader h = {};
+    h.moveCount = (uint16_t)(moveCount < RECORD_MAX_MOVES ? moveCount : RECORD_MAX_MOVES);
+    int w = Winner(final);
+    h.result = !finished ? RESULT_UNFINISHED : w == 0 ? RESULT_P1_WINS : w == 1 ? RESULT_P2_WINS : RESULT_DRAW;
+    h.stores[0] = final.seeds[B::STORE_P1];
+    h.stores[1] = final.seeds[B::STORE_P2];
+    return h;
+}
+
+// Ajoute une partie a un tampon (ecrit ensuite d'un bloc par GameRecordWriter::WriteEncoded)
+inline void EncodeGame(std::vector<uint8_t>& buffer, const GameRecordHeader& h, const uint8_t* moves) {
+    const uint8_t* raw = (const uint8_t*)&h;
+    buffer.insert(buffer.end(), raw, raw + sizeof(h));
+    buffer.insert(buffer.end(), moves, moves + h.moveCount);
+}
+
+// --- LECTURE (fichier projete en memoire, parcours sequentiel) ---
+struct GameRecordView {
+    GameRecordHeader header;
+    const uint8_t* moves; // header.moveCount octets, lus en place
+    uint64_t index;       // Rang de la partie dans le fichier
+};
+
+class GameRecordReader {
+public:
+    bool Open(const std::string& path) {
+        Close();
+        if (!file.Open(path)) {
+            std::cerr << "Archive de parties introuvable : " << path << std::endl;
+            return false;
+        }
+        if (file.Size() < sizeof(RecordFileHeader)) return Fail(path, "fichier trop court");
+        std::memcpy(&header, file.Data(), sizeof(header));
+        if (std::memcmp(header.magic, RECORD_MAGIC, 8) != 0) return Fail(path, "signature inconnue");
+        if (header.version != RECORD_VERSION) return Fail(path, "version non geree");
+        file.AdviseSequential();
+        Rewind();
+        return true;
+    }
+
+    void Close() {
+        file.Close();
+        offset = 0;
+        truncated = false;
+    }
+
+    bool IsOpen() const { return file.IsOpen(); }
+    const RecordFileHeader& Header() const { return header; }
+
+    template <class B>
+    bool IsFor() const {
+        return IsOpen() && header.pitsPerSide == (uint32_t)B::PITS_PER_SIDE && header.seedsPerPit == (uint32_t)B::SEEDS_PER_PIT
+            && header.rules == (uint32_t)B::Rules::CAPTURE;
+    }
+
+    void Rewind() {
+        offset = sizeof(RecordFileHeader);
+        next = 0;
+        truncated = false;
+    }
+
+    // Partie suivante (false a la fin, ou sur une partie coupee : voir Truncated)
+    bool Next(GameRecordView& out) {
+        size_t size = file.Size();
+        if (offset + sizeof(GameRecordHeader) > size) {
+            truncated = offset != size;
+            return false;
+        }
+        std::memcpy(&out.header, file.Data() + offset, sizeof(GameRecordHeader)); // Pas d'alignement garanti
+        if (offset + sizeof(GameRecordHeader) + out.header.moveCount > size) {
+            truncated = true;
+            return false;
+        }
+        out.moves = file.Data() + offset + sizeof(GameRecordHeader);
+        out.index = next++;
+        offset += sizeof(GameRecordHeader) + out.header.moveCount;
+        return true;
+    }
+
+    // La derniere partie est incomplete (ecriture interrompue) : elle est ignoree
+    bool Truncated() const { return truncated; }
+    // Octets des parties completes deja lues (en-tete compris)
+    size_t Offset() const { return offset; }
+
+private:
+    bool Fail(const std::string& path, const char* why) {
+        std::cerr << "Archive de parties invalide (" << why << ") : " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    MappedFile file;
+    RecordFileHeader header = {};
+    size_t offset = 0;
+    uint64_t next = 0;
+    bool truncated = false;
+};
+
+// Rejoue une partie depuis le depart. false si un coup est illegal ou si les
+// magasins finaux ne sont pas ceux de l'en-tete ; 'out' recoit la position finale.
+template <class B>
+bool ReplayGameRecord(const GameRecordView& g, B& out) {
+    out = B::Initial();
+    for (int i = 0; i < g.header.moveCount; i++) {
+        if (IsTerminal(out) || !IsLegalMove(out, g.moves[i])) return false;
+        ApplyMove(out, g.moves[i]);
+    }
+    if ((g.header.flags & RECORD_TRUNCATED) && !IsTerminal(out)) SweepRemaining(out);
+    return out.seeds[B::STORE_P1] == g.header.stores[0] && out.seeds[B::STORE_P2] == g.header.stores[1];
+}
+
+// --- EXPORT TEXTE (mise au point seulement) ---
+inline std::string RecordPlayerName(const GameRecordHeader& h, int player) {
+    static const char* NAMES[] = {"humain", "random", "greedy", "alphabeta", "mcts"};
+    int kind = h.players[player];
+    std::string name = kind <= PLAYER_MCTS ? NAMES[kind] : "?";
+    if (h.levels[player] == 0) return name;
+    bool timed = (h.flags & (player == 0 ? RECORD_P1_TIMED : RECORD_P2_TIMED)) != 0;
+    return name + ":" + std::to_string(h.levels[player]) + (timed ? "ms" : "");
+}
+
+// Une ligne par partie : joueurs, resultat, magasins, puis les trous joues
+inline std::string FormatGameRecord(const GameRecordView& g) {
+    static const char* RESULTS[] = {"J1 gagne", "J2 gagne", "egalite", "inachevee"};
+    const GameRecordHeader& h = g.header;
+    std::string s = "#" + std::to_string(g.index) + " " + RecordPlayerName(h, 0) + " vs " + RecordPlayerName(h, 1) + " | "
+                  + (h.result <= RESULT_UNFINISHED ? RESULTS[h.result] : "?") + " " + std::to_string(h.stores[0]) + "-"
+                  + std::to_string(h.stores[1]) + (h.flags & RECORD_TRUNCATED ? " (arretee)" : "") + " | "
+                  + std::to_string(h.moveCount) + " coups :";
+    for (int i = 0; i < h.moveCount; i++) s += " " + std::to_string(g.moves[i]);
+    return s;
+}
+
+// --- ECRITURE (ajout en fin de fichier) ---
+// Chaque partie part d'un seul bloc : un arret brutal ne peut couper que la
+// derniere, que Open() retire au prochain lancement. Plusieurs threads peuvent
+// ecrire dans le meme fichier (WriteEncoded est protege par un verrou).
+class GameRecordWriter {
+public:
+    // Cree l'archive ou la complete (meme variante exigee)
+    template <class B>
+    bool Open(const std::string& path) {
+        Close();
+        RecordFileHeader expected = MakeRecordFileHeader<B>();
+        size_t validEnd = sizeof(RecordFileHeader);
+        bool exists = false;
+        {
+            std::ifstream probe(path.c_str(), std::ios::binary | std::ios::ate);
+            exists = probe && probe.tellg() > 0;
+        }
+        if (exists) {
+            GameRecordReader existing;
+            if (!existing.Open(path)) return false;
+            if (!existing.IsFor<B>()) {
+                std::cerr << "Archive de parties d'une autre variante : " << path << std::endl;
+                return false;
+            }
+            GameRecordView g;
+            while (existing.Next(g)) {}
+            validEnd = existing.Offset();
+            if (existing.Truncated()) {
+                std::cerr << "Archive de parties : derniere partie incomplete retiree (" << path << ")" << std::endl;
+                existing.Close();
+                std::error_code error;
+                std::filesystem::resize_file(path, validEnd, error);
+                if (error) { std::cerr << "Impossible de reparer " << path << std::endl; return false; }
+            }
+        }
+
+        out.open(path.c_str(), std::ios::binary | std::ios::app);
+        if (!out) { std::cerr << "Impossible d'ecrire " << path << std::endl; return false; }
+        if (!exists) out.write((const char*)&expected, sizeof(expected));
+        out.flush();
+        return (bool)out;
+    }
+
+    void Close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (out.is_open()) out.close();
+    }
+
+    bool IsOpen() const { return out.is_open(); }
+
+    bool Write(const GameRecordHeader& h, const uint8_t* moves) {
+        std::vector<uint8_t> buffer;
+        EncodeGame(buffer, h, moves);
+        return WriteEncoded(buffer);
+    }
+
+    // Parties deja encodees par EncodeGame, ecrites d'un bloc
+    bool WriteEncoded(const std::vector<uint8_t>& games) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!out.is_open() || games.empty()) return false;
+        out.write((const char*)games.data(), (std::streamsize)games.size());
+        out.flush();
+        return (bool)out;
+    }
+
+private:
+    std::ofstream out;
+    std::mutex mutex;
+};
+
+#endif
@@ -0,0 +1,391 @@
+#ifndef GAMESERVER_HPP
+#define GAMESERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "Board.hpp"
+#include "MoveEvents.hpp"
+#include "Net.hpp"
+#include "Protocol.hpp"
+#include "Search.hpp"
+#include "TranspositionTable.hpp"
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+// Serveur de parties : un seul thread, une boucle epoll (declenchement par
+// niveau) pour toutes les connexions TCP et Unix. Chaque connexion a son tampon
+// d'entree (trames partielles) et de sortie : un client lent n'arrete jamais
+// la boucle, EPOLLOUT n'est demande que tant qu'il reste des octets a lui envoyer.
+// Les clients qui demandent un adversaire humain sont apparies deux a deux ;
+// l'ordinateur du serveur joue a faible profondeur, dans la boucle elle-meme.
+
+struct ServerConfig {
+    int aiDepth = 6;                 // Profondeur de l'ordinateur (quelques dizaines de microsecondes)
+    int hashMb = 16;                 // Table de transposition de l'ordinateur
+    size_t maxOutput = 1 << 20;      // Octets en attente au-dela desquels un client trop lent est coupe
+};
+
+struct ServerStats {
+    uint64_t accepted = 0;
+    uint64_t matches = 0;
+    uint64_t moves = 0;              // Coups joues (clients et ordinateur)
+    uint64_t frames = 0;             // Trames recues
+    uint64_t bytesIn = 0, bytesOut = 0;
+    size_t peakConnections = 0;
+};
+
+#ifdef __linux__
+
+template <class B>
+class GameServer {
+public:
+    explicit GameServer(const ServerConfig& config = ServerConfig()) : cfg(config), tt(config.hashMb) {
+        epoll = epoll_create1(0);
+    }
+
+    ~GameServer() {
+        for (auto& c : connections) CloseSocket(c.first);
+        for (SocketHandle l : listeners) CloseSocket(l);
+        if (epoll >= 0) close(epoll);
+    }
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    // Ecoute sur une adresse de plus (TCP et Unix peuvent etre servis ensemble)
+    bool Listen(const NetAddress& a) {
+        SocketHandle s = NetListen(a);
+        if (s == INVALID_SOCKET_HANDLE) {
+            std::cerr << "Ecoute impossible sur " << FormatNetAddress(a) << std::endl;
+            return false;
+        }
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = s;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, s, &ev);
+        listeners.push_back(s);
+        return true;
+    }
+
+    // Boucle d'evenements jusqu'a ce que 'stop' passe a vrai (verifie toutes les 100 ms)
+    void Run(const std::atomic<bool>& stop) {
+        epoll_event ready[256];
+        while (!stop.load(std::memory_order_relaxed)) {
+            int n = epoll_wait(epoll, ready, 256, 100);
+            for (int i = 0; i < n; i++) {
+                SocketHandle fd = ready[i].data.fd;
+                if (IsListener(fd)) { Accept(fd); continue; }
+                auto it = connections.find(fd);
+                if (it == connections.end() || it->second.closing) continue;
+                Connection& c = it->second;
+                if (ready[i].events & (EPOLLERR | EPOLLHUP)) c.closing = true;
+                if (!c.closing && (ready[i].events & EPOLLOUT)) Flush(c);
+                if (!c.closing && (ready[i].events & EPOLLIN)) Read(c);
+            }
+            // Fermetures regroupees en fin de lot : aucun descripteur n'est
+            // reutilise par un accept() tant que ses evenements sont en cours
+            for (SocketHandle fd : closing) Drop(fd);
+            closing.clear();
+        }
+    }
+
+    const ServerStats& Stats() const { return stats; }
+    size_t Connections() const { return connections.size(); }
+
+private:
+    struct Connection {
+        SocketHandle fd = INVALID_SOCKET_HANDLE;
+        FrameBuffer in;
+        std::vector<uint8_t> out;
+        size_t outPos = 0;
+        bool writing = false;        // EPOLLOUT demande
+        bool closing = false;
+        uint32_t match = 0;          // 0 : hors partie
+        int seat = 0;
+    };
+
+    struct Match {
+        B board;
+        SocketHandle players[2];     // INVALID_SOCKET_HANDLE : l'ordinateur
+    };
+
+    bool IsListener(SocketHandle fd) const {
+        for (SocketHandle l : listeners) {
+            if (l == fd) return true;
+        }
+        return false;
+    }
+
+    void Accept(SocketHandle listener) {
+        for (;;) {
+            SocketHandle s = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK);
+            if (s < 0) return; // EAGAIN : plus rien en attente (ou plus de descripteurs)
+            int on = 1;
+            setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)); // Sans effet (echec) sur un socket Unix
+            epoll_event ev = {};
+            ev.events = EPOLLIN;
+            ev.data.fd = s;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, s, &ev);
+            Connection& c = connections[s];
+            c.fd = s;
+            stats.accepted++;
+            if (connections.size() > stats.peakConnections) stats.peakConnections = connections.size();
+        }
+    }
+
+    void Read(Connection& c) {
+        uint8_t buffer[16384];
+        for (;;) {
+            long n = NetReceive(c.fd, buffer, sizeof(buffer));
+            if (n > 0) {
+                stats.bytesIn += (uint64_t)n;
+                c.in.Append(buffer, (size_t)n);
+                if ((size_t)n < sizeof(buffer)) break;
+                continue;
+            }
+            if (n < 0 && NetWouldBlock()) break;
+            Close(c); // n == 0 : le client est parti
+            return;
+        }
+        NetMessage m;
+        bool bad = false;
+        while (!c.closing && c.in.Next(m, bad)) {
+            stats.frames++;
+            Dispatch(c, m);
+        }
+        if (bad) Close(c);
+    }
+
+    void Dispatch(Connection& c, const NetMessage& m) {
+        switch (m.type) {
+        case MSG_JOIN:
+            if (m.size != 1) { SendError(c, NET_ERR_BAD_MESSAGE); return; }
+            Join(c, m.payload[0] == NET_OPPONENT_AI);
+            return;
+        case MSG_MOVE:
+            if (m.size != 1) { SendError(c, NET_ERR_BAD_MESSAGE); return; }
+            Move(c, m.payload[0]);
+            return;
+        case MSG_LEAVE:
+            Leave(c);
+            return;
+        default:
+            SendError(c, NET_ERR_BAD_MESSAGE);
+        }
+    }
+
+    // --- PARTIES ---
+    void Join(Connection& c, bool vsAi) {
+        if (c.match != 0 || waiting == c.fd) { SendError(c, NET_ERR_ALREADY_PLAYING); return; }
+        uint32_t id = nextMatch++;
+        if (vsAi) {
+            Match& match = matches[id];
+            match.board = B::Initial();
+            c.seat = (int)(id & 1); // Le client commence une partie sur deux
+            match.players[c.seat] = c.fd;
+            match.players[1 - c.seat] = INVALID_SOCKET_HANDLE;
+            c.match = id;
+            stats.matches++;
+            frame.clear();
+            AppendMatchFrame(frame, id, c.seat, NET_OPPONENT_AI, match.board);
+            Send(c, frame);
+            PlayAi(id);
+            return;
+        }
+
+        auto other = connections.find(waiting);
+        if (other == connections.end() || other->second.closing) {
+            waiting = c.fd;
+            return;
+        }
+        waiting = INVALID_SOCKET_HANDLE;
+        Match& match = matches[id];
+        match.board = B::Initial();
+        match.players[0] = other->second.fd; // Le premier arrive commence
+        match.players[1] = c.fd;
+        other->second.match = c.match = id;
+        other->second.seat = 0;
+        c.seat = 1;
+        stats.matches++;
+        for (int seat = 0; seat < 2; seat++) {
+            frame.clear();
+            AppendMatchFrame(frame, id, seat, NET_OPPONENT_CLIENT, match.board);
+            Send(seat == 0 ? other->second : c, frame);
+        }
+    }
+
+    void Move(Connection& c, int pit) {
+        auto it = matches.find(c.match);
+        if (it == matches.end()) { SendError(c, NET_ERR_NO_MATCH); return; }
+        B& board = it->second.board;
+        if (board.sideToMove != c.seat) { SendError(c, NET_ERR_NOT_YOUR_TURN); return; }
+        if (pit >= B::NUM_PITS || !IsLegalMove(board, pit)) { SendError(c, NET_ERR_ILLEGAL_MOVE); return; }
+        if (Play(c.match, pit)) PlayAi(c.match);
+    }
+
+    // Joue le coup et envoie son deroulement aux deux joueurs ; false si la partie est finie
+    bool Play(uint32_t id, int pit) {
+        Match& match = matches[id];
+        MoveResult r = RecordMove(match.board, pit, events);
+        stats.moves++;
+        frame.clear();
+        AppendEventsFrame(frame, events);
+        for (int seat = 0; seat < 2; seat++) {
+            auto p = connections.find(match.players[seat]);
+            if (p != connections.end()) Send(p->second, frame);
+        }
+        if (!r.gameOver) return true;
+        EndMatch(id);
+        return false;
+    }
+
+    // Coups de l'ordinateur tant qu'il a le trait (il peut rejouer)
+    void PlayAi(uint32_t id) {
+        for (;;) {
+            auto it = matches.find(id);
+            if (it == matches.end()) return;
+            Match& match = it->second;
+            if (match.players[match.board.sideToMove] != INVALID_SOCKET_HANDLE) return;
+            SearchLimits limits;
+            limits.maxDepth = cfg.aiDepth;
+            int pit = SearchPosition(match.board, limits, &tt).bestMove;
+            if (pit < 0 || !Play(id, pit)) return;
+        }
+    }
+
+    void EndMatch(uint32_t id) {
+        auto it = matches.find(id);
+        if (it == matches.end()) return;
+        for (int seat = 0; seat < 2; seat++) {
+            auto p = connections.find(it->second.players[seat]);
+            if (p != connections.end() && p->second.match == id) p->second.match = 0;
+        }
+        matches.erase(it);
+    }
+
+    // Le client quitte sa partie (ou la file d'attente) ; son adversaire est prevenu
+    void Leave(Connection& c) {
+        if (waiting == c.fd) waiting = INVALID_SOCKET_HANDLE;
+        auto it = matches.find(c.match);
+        if (it == matches.end()) { c.match = 0; return; }
+        auto opponent = connections.find(it->second.players[1 - c.seat]);
+        if (opponent != connections.end()) {
+            frame.clear();
+            AppendFrame(frame, MSG_OPPONENT_LEFT);
+            Send(opponent->second, frame);
+        }
+        EndMatch(c.match);
+    }
+
+    // --- ENVOI ---
+    void SendError(Connection& c, NetError e) {
+        uint8_t code = e;
+        std::vector<uint8_t> error;
+        AppendFrame(error, MSG_ERROR, &code, 1);
+        Send(c, error);
+    }
+
+    // Ecrit tout de suite ce que le socket accepte, garde le reste pour EPOLLOUT
+    void Send(Connection& c, const std::vector<uint8_t>& bytes) {
+        if (c.closing) return;
+        size_t offset = 0;
+        if (c.outPos == c.out.size()) {
+            c.out.clear();
+            c.outPos = 0;
+            while (offset < bytes.size()) {
+                long n = NetSend(c.fd, bytes.data() + offset, bytes.size() - offset);
+                if (n > 0) { offset += (size_t)n; stats.bytesOut += (uint64_t)n; continue; }
+                if (n < 0 && NetWouldBlock()) break;
+                Close(c);
+                return;
+            }
+            if (offset == bytes.size()) return;
+        }
+        c.out.insert(c.out.end(), bytes.begin() + offset, bytes.end());
+        if (c.out.size() - c.outPos > cfg.maxOutput) { Close(c); return; }
+        WatchOutput(c, true);
+    }
+
+    void Flush(Connection& c) {
+        while (c.outPos < c.out.size()) {
+            long n = NetSend(c.fd, c.out.data() + c.outPos, c.out.size() - c.outPos);
+            if (n > 0) { c.outPos += (size_t)n; stats.bytesOut += (uint64_t)n; continue; }
+            if (n < 0 && NetWouldBlock()) return;
+            Close(c);
+            return;
+        }
+        c.out.clear();
+        c.outPos = 0;
+        WatchOutput(c, false);
+    }
+
+    void WatchOutput(Connection& c, bool on) {
+        if (c.writing == on) return;
+        epoll_event ev = {};
+        ev.events = on ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+        ev.data.fd = c.fd;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, c.fd, &ev);
+        c.writing = on;
+    }
+
+    // Fermeture differee a la fin du lot d'evenements (voir Run)
+    void Close(Connection& c) {
+        if (c.closing) return;
+        c.closing = true;
+        closing.push_back(c.fd);
+    }
+
+    void Drop(SocketHandle fd) {
+        auto it = connections.find(fd);
+        if (it == connections.end()) return;
+        Leave(it->second);
+        epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+        CloseSocket(fd);
+        connections.erase(it);
+    }
+
+    ServerConfig cfg;
+    int epoll = -1;
+    std::vector<SocketHandle> listeners;
+    std::unordered_map<SocketHandle, Connection> connections;
+    std::unordered_map<uint32_t, Match> matches;
+    std::vector<SocketHandle> closing;
+    SocketHandle waiting = INVALID_SOCKET_HANDLE; // Client en attente d'un adversaire
+    uint32_t nextMatch = 1;
+
+    MoveEventStream<B> events;
+    std::vector<uint8_t> frame;
+    TranspositionTable tt;
+    ServerStats stats;
+};
+
+#else
+
+// epoll n'existe que sous Linux : ailleurs le jeu 3D reste client seulement
+template <class B>
+class GameServer {
+public:
+    explicit GameServer(const ServerConfig& = ServerConfig()) {}
+
+    bool Listen(const NetAddress&) {
+        std::cerr << "Serveur de parties disponible sous Linux seulement (epoll)" << std::endl;
+        return false;
+    }
+
+    void Run(const std::atomic<bool>&) {}
+    const ServerStats& Stats() const { return stats; }
+    size_t Connections() const { return 0; }
+
+private:
+    ServerStats stats;
+};
+
+#endif
+
+#endif
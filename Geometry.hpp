@@ -2,11 +2,33 @@
 #define GEOMETRY_HPP
 
 #include "Mesh.hpp"
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
 class Geometry {
 public:
-    static Mesh CreateCube() {
+    // Pieces fixes fusionnees en un seul maillage, dans l'ordre donne : sommets
+    // passes en coordonnees du monde (normales corrigees des echelles non uniformes)
+    static Mesh Bake(const std::vector<std::pair<const Mesh*, glm::mat4>>& parts) {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        for (const auto& part : parts) {
+            glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(part.second)));
+            unsigned int base = (unsigned int)vertices.size();
+            for (const Vertex& v : part.first->vertices) {
+                Vertex w = v;
+                w.Position = glm::vec3(part.second * glm::vec4(v.Position, 1.0f));
+                w.Normal = glm::normalize(normalMatrix * v.Normal);
+                vertices.push_back(w);
+            }
+            for (unsigned int i : part.first->indices) indices.push_back(base + i);
+        }
+        return Mesh(vertices, indices);
+    }
+
+    // Sans dessus ni dessous (capped = false) : les 4 faces laterales seules
+    static Mesh CreateCube(bool capped = true) {
         std::vector<Vertex> vertices = {
             {{-0.5f, -0.5f, -0.5f},  {0.0f,  0.0f, -1.0f}, {0.0f, 0.0f}},
             {{ 0.5f,  0.5f, -0.5f},  {0.0f,  0.0f, -1.0f}, {1.0f, 1.0f}},
@@ -45,8 +67,72 @@ public:
             {{ 0.5f,  0.5f, -0.5f},  {0.0f,  1.0f,  0.0f}, {1.0f, 1.0f}},
             {{-0.5f,  0.5f, -0.5f},  {0.0f,  1.0f,  0.0f}, {0.0f, 1.0f}}
         };
+        if (!capped) vertices.resize(24); // Dessous puis dessus en fin de liste
+        std::vector<unsigned int> indices;
+        for(unsigned int i=0; i<vertices.size(); i++) indices.push_back(i);
+        return Mesh(vertices, indices);
+    }
+
+    // Dessus du plateau : plan y = 0 de size.x sur size.y centre a l'origine (memes UV que le
+    // dessus de CreateCube), perce de trous elliptiques (centre x, z puis rayons x, z) qui ne se
+    // chevauchent pas. Chaque trou a sectorCount cotes aux angles des meridiens de CreateBowl.
+    // Decoupe en tranches verticales aux abscisses des sommets : les tranches voisines
+    // partagent exactement leurs sommets (pas de fissure en T).
+    static Mesh CreateBoardTop(glm::vec2 size, const std::vector<glm::vec4>& holes, int sectorCount = 36) {
+        std::vector<Vertex> vertices;
         std::vector<unsigned int> indices;
-        for(unsigned int i=0; i<36; i++) indices.push_back(i);
+        int half = sectorCount / 2;
+
+        // Demi-bord de chaque trou, x decroissant de l'angle 0 a pi : (x, demi-largeur en z)
+        std::vector<std::vector<glm::vec2>> rims;
+        std::vector<float> cuts = {-size.x / 2, size.x / 2};
+        for (const glm::vec4& hole : holes) {
+            std::vector<glm::vec2> rim;
+            for (int j = 0; j <= half; ++j) {
+                float angle = j * M_PI / half;
+                rim.push_back({hole.x + hole.z * cosf(angle), (j == 0 || j == half) ? 0.0f : hole.w * sinf(angle)});
+                cuts.push_back(rim.back().x);
+            }
+            rims.push_back(rim);
+        }
+        std::sort(cuts.begin(), cuts.end());
+        cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+        // Demi-largeur du trou k a l'abscisse x (meme calcul de part et d'autre d'une coupe)
+        auto halfWidth = [&](int k, float x) {
+            const std::vector<glm::vec2>& rim = rims[k];
+            for (int j = 0; j < half; ++j) {
+                if (x > rim[j].x || x < rim[j + 1].x) continue;
+                if (x == rim[j].x) return rim[j].y;
+                if (x == rim[j + 1].x) return rim[j + 1].y;
+                float t = (rim[j].x - x) / (rim[j].x - rim[j + 1].x);
+                return rim[j].y + t * (rim[j + 1].y - rim[j].y);
+            }
+            return 0.0f;
+        };
+        auto addVertex = [&](float x, float z) {
+            vertices.push_back({{x, 0.0f, z}, {0.0f, 1.0f, 0.0f}, {x / size.x + 0.5f, 0.5f - z / size.y}});
+        };
+
+        for (size_t c = 0; c + 1 < cuts.size(); ++c) {
+            float x0 = cuts[c], x1 = cuts[c + 1], middle = (x0 + x1) / 2;
+            // Trous traverses par la tranche, par z croissant
+            std::vector<int> crossed;
+            for (int k = 0; k < (int)holes.size(); ++k)
+                if (rims[k].back().x < middle && rims[k].front().x > middle) crossed.push_back(k);
+            std::sort(crossed.begin(), crossed.end(), [&](int a, int b) { return holes[a].y < holes[b].y; });
+
+            // Bandes pleines : du bord du plateau au premier trou, entre trous, puis jusqu'a l'autre bord
+            float low0 = -size.y / 2, low1 = -size.y / 2;
+            for (size_t i = 0; i <= crossed.size(); ++i) {
+                float high0 = size.y / 2, high1 = size.y / 2;
+                if (i < crossed.size()) { high0 = holes[crossed[i]].y - halfWidth(crossed[i], x0); high1 = holes[crossed[i]].y - halfWidth(crossed[i], x1); }
+                unsigned int base = vertices.size();
+                addVertex(x0, low0); addVertex(x0, high0); addVertex(x1, high1); addVertex(x1, low1);
+                indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+                if (i < crossed.size()) { low0 = holes[crossed[i]].y + halfWidth(crossed[i], x0); low1 = holes[crossed[i]].y + halfWidth(crossed[i], x1); }
+            }
+        }
         return Mesh(vertices, indices);
     }
 
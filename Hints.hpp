@@ -0,0 +1,242 @@
+#ifndef HINTS_HPP
+#define HINTS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Board.hpp"
+#include "EndgameDb.hpp"
+#include "Search.hpp"
+#include "TranspositionTable.hpp"
+#include "Zobrist.hpp"
+
+// Conseils : le score de chaque coup de la position affichee, calcule en
+// continu sur un thread a part. Chaque coup est cherche a fenetre pleine
+// (score exact, pas seulement "moins bon que le meilleur"), profondeur apres
+// profondeur.
+//
+// Le thread ne s'arrete pas a la position courante : il approfondit aussi
+// les positions apres chaque coup, et apres chaque reponse (un petit arbre de
+// deux demi-coups). Quand un coup est joue, le noeud de la position atteinte
+// devient la racine avec tout ce qui a deja ete calcule dessous ; le reste de
+// l'arbre est libere. Les conseils de la position suivante sont donc la des
+// le debut de l'animation, sans repartir de zero.
+
+const int HINT_TREE_LEVELS = 2; // Demi-coups d'avance gardes sous la racine
+
+// Scores publies pour l'affichage (point de vue du joueur au trait)
+template <class B>
+struct HintScores {
+    uint64_t key = 0;             // Position concernee (0 : rien)
+    int depth = 0;                // Profondeur complete
+    int count = 0;
+    int moves[B::PITS_PER_SIDE];
+    int scores[B::PITS_PER_SIDE];
+};
+
+template <class B>
+class HintWorker {
+public:
+    explicit HintWorker(const EndgameTable& egtb, size_t hashMb = 16, int maxDepth = 24)
+        : egtb(egtb), tt(hashMb), maxDepth(maxDepth) {
+        thread = std::thread([this]() { Run(); });
+    }
+
+    ~HintWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+            stop.store(true, std::memory_order_relaxed);
+        }
+        wake.notify_all();
+        thread.join();
+    }
+
+    HintWorker(const HintWorker&) = delete;
+    HintWorker& operator=(const HintWorker&) = delete;
+
+    // Nouvelle position a conseiller (souvent un descendant de la precedente)
+    void SetRoot(const B& position) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = position;
+        hasPending = true;
+        stop.store(true, std::memory_order_relaxed);
+        wake.notify_all();
+    }
+
+    // Plus de conseils : l'arbre est libere, le thread s'endort
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        hasPending = false;
+        clearRequested = true;
+        published = HintScores<B>();
+        stop.store(true, std::memory_order_relaxed);
+        wake.notify_all();
+    }
+
+    // Derniers scores de la racine ; jamais bloquant (false si le thread publie a cet instant)
+    bool Poll(HintScores<B>& out) {
+        std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock()) return false;
+        out = published;
+        return true;
+    }
+
+private:
+    struct Node {
+        B position;
+        typename B::MoveList moves;
+        int depth = 0;
+        int scores[B::PITS_PER_SIDE];
+        std::unique_ptr<Node> children[B::PITS_PER_SIDE]; // Position apres chaque coup
+    };
+
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            Node* node = nullptr;
+            wake.wait(lock, [&]() {
+                if (quit || hasPending || clearRequested) return true;
+                node = root ? Pick(root.get(), 0) : nullptr;
+                return node != nullptr;
+            });
+            if (quit) return;
+            if (clearRequested) {
+                clearRequested = false;
+                root.reset();
+                continue;
+            }
+            if (hasPending) {
+                Reroot(pending);
+                hasPending = false;
+                stop.store(false, std::memory_order_relaxed);
+                Publish();
+                continue;
+            }
+            int depth = node->depth + 1;
+            lock.unlock();
+
+            int scores[B::PITS_PER_SIDE];
+            bool done = Deepen(*node, depth, scores);
+
+            lock.lock();
+            if (!done || hasPending || clearRequested) continue; // Iteration interrompue : ignoree
+            for (int i = 0; i < node->moves.count; i++) node->scores[i] = scores[i];
+            node->depth = depth;
+            if (node == root.get()) Publish();
+        }
+    }
+
+    // La racine devient le noeud deja calcule pour 'position' s'il est dans
+    // l'arbre (coup joue, ou coup et reponse) ; les autres branches sont liberees
+    void Reroot(const B& position) {
+        uint64_t key = HashPosition(position);
+        std::unique_ptr<Node> found;
+        if (root && HashPosition(root->position) == key) found = std::move(root);
+        for (int i = 0; root && !found && i < root->moves.count; i++) {
+            Node* child = root->children[i].get();
+            if (!child) continue;
+            if (HashPosition(child->position) == key) { found = std::move(root->children[i]); break; }
+            for (int j = 0; j < child->moves.count; j++) {
+                if (child->children[j] && HashPosition(child->children[j]->position) == key) {
+                    found = std::move(child->children[j]);
+                    break;
+                }
+            }
+        }
+        if (!found) {
+            found.reset(new Node());
+            found->position = position;
+            found->moves = LegalMoves(position);
+        }
+        root = std::move(found); // L'ancienne racine et ses autres branches sont liberees ici
+        Expand(root.get(), 0);
+        tt.NewSearch(); // Les entrees des branches abandonnees deviennent remplacables en priorite
+    }
+
+    // Cree les noeuds manquants jusqu'a HINT_TREE_LEVELS sous la racine
+    void Expand(Node* node, int level) {
+        if (level >= HINT_TREE_LEVELS) return;
+        for (int i = 0; i < node->moves.count; i++) {
+            if (!node->children[i]) {
+                B child = node->position;
+                ApplyMove(child, node->moves.moves[i]);
+                if (IsTerminal(child)) continue;
+                node->children[i].reset(new Node());
+                node->children[i]->position = child;
+                node->children[i]->moves = LegalMoves(child);
+            }
+            Expand(node->children[i].get(), level + 1);
+        }
+    }
+
+    // Noeud a approfondir : la racine d'abord, ses descendants avec deux
+    // niveaux de retard par demi-coup (ils servent moins souvent)
+    Node* Pick(Node* node, int level) {
+        Node* best = nullptr;
+        int bestKey = 0;
+        PickIn(node, level, best, bestKey);
+        return best;
+    }
+
+    void PickIn(Node* node, int level, Node*& best, int& bestKey) {
+        if (node->depth < maxDepth && node->moves.count > 0) {
+            int key = node->depth + 2 * level;
+            if (!best || key < bestKey) { best = node; bestKey = key; }
+        }
+        for (int i = 0; i < node->moves.count; i++) {
+            if (node->children[i]) PickIn(node->children[i].get(), level + 1, best, bestKey);
+        }
+    }
+
+    // Score exact de chaque coup a 'depth' (false si interrompu)
+    bool Deepen(const Node& node, int depth, int scores[]) {
+        SearchContext ctx;
+        ctx.tt = &tt;
+        ctx.egtb = &egtb;
+        ctx.sharedStop = &stop;
+        for (int i = 0; i < node.moves.count; i++) {
+            B child = node.position;
+            ApplyMove(child, node.moves.moves[i]);
+            int score = depth <= 1 || IsTerminal(child) ? Evaluate(child, &egtb)
+                      : AlphaBeta(child, HashPosition(child), depth - 1, 1, -SCORE_INF, SCORE_INF, ctx);
+            if (ctx.stopped) return false;
+            scores[i] = child.sideToMove == node.position.sideToMove ? score : -score;
+        }
+        return true;
+    }
+
+    void Publish() {
+        HintScores<B> s;
+        s.key = HashPosition(root->position);
+        s.depth = root->depth;
+        s.count = root->moves.count;
+        for (int i = 0; i < s.count; i++) {
+            s.moves[i] = root->moves.moves[i];
+            s.scores[i] = root->scores[i];
+        }
+        published = s;
+    }
+
+    const EndgameTable& egtb;
+    TranspositionTable tt; // Propre aux conseils : l'ordinateur garde la sienne
+    int maxDepth;
+
+    std::unique_ptr<Node> root; // Thread des conseils seulement
+    std::atomic<bool> stop{false};
+    std::mutex mutex;
+    std::condition_variable wake;
+    B pending;
+    bool hasPending = false;
+    bool clearRequested = false;
+    bool quit = false;
+    HintScores<B> published;
+
+    std::thread thread; // Lance dans le constructeur, une fois tous les membres prets
+};
+
+#endif
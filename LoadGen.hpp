@@ -0,0 +1,232 @@
+#ifndef LOADGEN_HPP
+#define LOADGEN_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "Board.hpp"
+#include "MoveEvents.hpp"
+#include "Net.hpp"
+#include "Protocol.hpp"
+#include "Rng.hpp"
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+// Generateur de charge du serveur de parties : des centaines ou des milliers
+// de clients dans un seul thread (epoll), qui jouent des coups aleatoires legaux
+// aussi vite que le serveur repond. La latence mesuree va de l'envoi d'un coup
+// a la reception de son deroulement (MSG_EVENTS) ; chaque client suit aussi la
+// partie de son cote et verifie que le serveur annonce bien le meme trait.
+
+struct LoadGenConfig {
+    NetAddress address;
+    int clients = 200;
+    long games = 2000;        // Parties a terminer
+    bool vsAi = false;        // Contre l'ordinateur du serveur (sinon les clients s'affrontent)
+    uint64_t seed = 1;
+    int timeoutSeconds = 120; // Garde-fou si le serveur cesse de repondre
+};
+
+struct LoadGenReport {
+    long connected = 0;
+    long games = 0;
+    long moves = 0;           // Coups envoyes par les clients
+    long errors = 0;          // MSG_ERROR, desaccords avec le serveur, connexions perdues
+    bool timedOut = false;
+    double seconds = 0.0;
+    std::vector<uint32_t> latencyUs; // Une mesure par coup envoye (triees a la fin)
+
+    // Percentile 0..1 des latences (triees)
+    uint32_t Percentile(double p) const {
+        if (latencyUs.empty()) return 0;
+        size_t i = (size_t)(p * (latencyUs.size() - 1) + 0.5);
+        return latencyUs[std::min(i, latencyUs.size() - 1)];
+    }
+};
+
+#ifdef __linux__
+
+template <class B>
+LoadGenReport RunLoadGen(const LoadGenConfig& cfg) {
+    typedef std::chrono::steady_clock Clock;
+    struct Client {
+        SocketHandle fd = INVALID_SOCKET_HANDLE;
+        FrameBuffer in;
+        std::vector<uint8_t> out;
+        bool writing = false;
+        bool inMatch = false;
+        int seat = 0;
+        int pending = -1;             // Coup envoye dont on attend le deroulement
+        Clock::time_point sent;
+        B board;
+        Rng rng;
+    };
+
+    LoadGenReport report;
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::seconds(cfg.timeoutSeconds);
+    int epoll = epoll_create1(0);
+    std::vector<Client> clients(cfg.clients);
+    long open = 0;
+    MoveEventStream<B> events;
+
+    auto watchOutput = [&](Client& c, int index, bool on) {
+        if (c.writing == on) return;
+        epoll_event ev = {};
+        ev.events = on ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+        ev.data.u32 = (uint32_t)index;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, c.fd, &ev);
+        c.writing = on;
+    };
+    auto flush = [&](Client& c, int index) {
+        size_t sent = 0;
+        while (sent < c.out.size()) {
+            long n = NetSend(c.fd, c.out.data() + sent, c.out.size() - sent);
+            if (n > 0) { sent += (size_t)n; continue; }
+            break; // Plein : le reste partira sur EPOLLOUT
+        }
+        c.out.erase(c.out.begin(), c.out.begin() + sent);
+        watchOutput(c, index, !c.out.empty());
+    };
+    auto drop = [&](Client& c) {
+        if (c.fd == INVALID_SOCKET_HANDLE) return;
+        epoll_ctl(epoll, EPOLL_CTL_DEL, c.fd, nullptr);
+        CloseSocket(c.fd);
+        c.fd = INVALID_SOCKET_HANDLE;
+        open--;
+    };
+    auto join = [&](Client& c, int index) {
+        if (report.games >= cfg.games) { drop(c); return; }
+        uint8_t opponent = cfg.vsAi ? NET_OPPONENT_AI : NET_OPPONENT_CLIENT;
+        AppendFrame(c.out, MSG_JOIN, &opponent, 1);
+        flush(c, index);
+    };
+    auto play = [&](Client& c, int index) {
+        typename B::MoveList moves = LegalMoves(c.board);
+        uint8_t pit = (uint8_t)moves.moves[c.rng.Below(moves.count)];
+        c.pending = pit;
+        c.sent = Clock::now();
+        AppendFrame(c.out, MSG_MOVE, &pit, 1);
+        report.moves++;
+        flush(c, index);
+    };
+
+    // Un message du serveur ; false si le client doit etre coupe
+    auto handle = [&](Client& c, int index, const NetMessage& m) -> bool {
+        if (m.type == MSG_MATCH) {
+            uint32_t id;
+            int opponent;
+            if (!DecodeMatchFrame(m, id, c.seat, opponent, c.board)) return false;
+            c.inMatch = true;
+            if (c.board.sideToMove == c.seat) play(c, index);
+            return true;
+        }
+        if (m.type == MSG_EVENTS) {
+            if (!c.inMatch || !DecodeEventsFrame(m, events)) return false;
+            int pit = events.events[0].pit;
+            if (c.pending >= 0) {
+                if (pit != c.pending) return false;
+                report.latencyUs.push_back((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - c.sent).count());
+                c.pending = -1;
+            }
+            if (!IsLegalMove(c.board, pit)) return false;
+            MoveResult r = ApplyMove(c.board, pit);
+            const MoveEvent& last = events.events[events.count - 1];
+            if (r.gameOver != (last.type == EV_GAME_OVER)) return false;
+            if (r.gameOver) {
+                c.inMatch = false;
+                if (cfg.vsAi || c.seat == 0) report.games++; // Une partie entre clients est vue deux fois
+                join(c, index);
+            } else {
+                if (last.pit != c.board.sideToMove) return false;
+                if (c.board.sideToMove == c.seat) play(c, index);
+            }
+            return true;
+        }
+        if (m.type == MSG_OPPONENT_LEFT) {
+            c.inMatch = false;
+            c.pending = -1;
+            join(c, index);
+            return true;
+        }
+        report.errors++; // MSG_ERROR ou message inconnu : on continue
+        return true;
+    };
+
+    // Connexions (bloquantes : le serveur accepte au fil de l'eau), puis demandes de partie
+    for (int i = 0; i < cfg.clients; i++) {
+        Client& c = clients[i];
+        c.rng = Rng(cfg.seed, (uint64_t)i + 1);
+        c.fd = NetConnect(cfg.address);
+        if (c.fd == INVALID_SOCKET_HANDLE || !SetNonBlocking(c.fd)) {
+            std::cerr << "Connexion " << i << " refusee par " << FormatNetAddress(cfg.address) << std::endl;
+            CloseSocket(c.fd);
+            c.fd = INVALID_SOCKET_HANDLE;
+            report.errors++;
+            continue;
+        }
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.u32 = (uint32_t)i;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, c.fd, &ev);
+        open++;
+        report.connected++;
+    }
+    for (int i = 0; i < cfg.clients; i++) {
+        if (clients[i].fd != INVALID_SOCKET_HANDLE) join(clients[i], i);
+    }
+
+    std::vector<epoll_event> ready(1024);
+    uint8_t buffer[16384];
+    while (open > 0 && report.games < cfg.games) {
+        if (Clock::now() > deadline) { report.timedOut = true; break; }
+        int n = epoll_wait(epoll, ready.data(), (int)ready.size(), 100);
+        for (int k = 0; k < n; k++) {
+            int index = (int)ready[k].data.u32;
+            Client& c = clients[index];
+            if (c.fd == INVALID_SOCKET_HANDLE) continue;
+            if (ready[k].events & EPOLLOUT) flush(c, index);
+            if (!(ready[k].events & (EPOLLIN | EPOLLERR | EPOLLHUP))) continue;
+            bool alive = true;
+            for (;;) {
+                long got = NetReceive(c.fd, buffer, sizeof(buffer));
+                if (got > 0) { c.in.Append(buffer, (size_t)got); if ((size_t)got < sizeof(buffer)) break; continue; }
+                if (got < 0 && NetWouldBlock()) break;
+                alive = false;
+                break;
+            }
+            NetMessage m;
+            bool bad = false;
+            while (alive && c.fd != INVALID_SOCKET_HANDLE && c.in.Next(m, bad)) alive = handle(c, index, m);
+            if (!alive || bad) {
+                report.errors++;
+                drop(c);
+            }
+        }
+    }
+
+    for (Client& c : clients) drop(c);
+    close(epoll);
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::sort(report.latencyUs.begin(), report.latencyUs.end());
+    return report;
+}
+
+#else
+
+template <class B>
+LoadGenReport RunLoadGen(const LoadGenConfig&) {
+    std::cerr << "Generateur de charge disponible sous Linux seulement (epoll)" << std::endl;
+    LoadGenReport report;
+    report.errors = 1;
+    return report;
+}
+
+#endif
+
+#endif
@@ -1,23 +1,32 @@
 #ifndef MANCALAGAME_HPP
 #define MANCALAGAME_HPP
 
+#include <deque>
 #include <vector>
-#include <queue>
 #include <glm/glm.hpp>
 #include <iostream>
 #include <string>
 
-// Structure reprsentant un trou (fosse) ou un magasin
+#include "AIWorker.hpp"
+#include "Board.hpp"
+#include "GameRecord.hpp"
+#include "Hints.hpp"
+#include "MoveEvents.hpp"
+#include "MoveLog.hpp"
+#include "Net.hpp"
+#include "OpeningBook.hpp"
+#include "Search.hpp"
+
+// Structure reprsentant un trou (fosse) ou un magasin.
+// Uniquement les donnes de rendu/clic : les graines vivent dans MancalaGame::board
 struct Pit {
-    int id;             // Index (0-13)
-    int seeds;          // Nombre de graines
+    int id;             // Index (0-13 pour le Kalah 6 trous)
     glm::vec3 position; // Position 3D
     float radius;       // Rayon pour le clic
     bool isSelected;    // tat slectionn
     bool isHovered;     // tat survol
     bool isHidden;      // (Non utilis, mais prsent)
     bool isActive;      // C'est le tour de ce trou ?
-    float depth;        // (Non utilis ici)
 };
 
 enum GameState {
@@ -33,81 +42,443 @@ struct MovingSeed {
     int targetPitIndex;
 };
 
-class MancalaGame {
+// Vue 3D au-dessus de Board : les rgles sont dans Board.hpp,
+// ici on ne fait qu'animer la distribution et grer les clics.
+// Instanciable pour n'importe quelle variante (Kalah6x4, Kalah6x6, Oware6x4...).
+template <class BoardT>
+class BasicMancalaGame {
 public:
+    typedef BoardT BoardType;
+    static constexpr int N = BoardT::PITS_PER_SIDE;
+
+    BoardT board;           // Graines affiches (+ joueur au trait)
+    BoardT position;        // Position aprs le dernier coup (board est en retard pendant l'animation)
+    MoveLog<BoardT> history; // Coups jous : annuler / refaire / aller  un coup
+    GameRecordWriter recorder; // Archive des parties (facultative) : chaque partie finie y est ajoute
     std::vector<Pit> pits;
     GameState state;
-    int currentPlayer;      // 0 = Bas, 1 = Haut
     bool gameOver;
     std::string statusMessage;
-    std::vector<int> pathQueue; // Liste des prochains trous  visiter
+    MoveEventStream<BoardT> moveEvents; // Droulement du dernier coup (rutilis  chaque coup)
+    MoveEventCursor eventCursor;        // Prochain vnement  animer
     MovingSeed activeSeed;
-    int seedsInHand;        // Graines en main pour la distribution
     float moveSpeed;
 
-    MancalaGame() {
+    // --- ORDINATEUR ---
+    bool aiPlays[2];         // Le joueur est-il jou par l'ordinateur ? (J2 par dfaut)
+    AIEngine aiEngine;
+    SearchLimits aiLimits;   // Budget par coup (aussi utilis par le MCTS)
+    bool aiPonder;           // Rflchir pendant le tour de l'humain (alpha-beta seulement)
+    TranspositionTable aiTable; // Garde d'un coup  l'autre : la recherche suivante repart de ce qui est connu
+    EndgameTable endgame;       // Base de finales (facultative) : jeu parfait et issue annonce en fin de partie
+    OpeningBook book;           // Livre d'ouvertures (facultatif) : rponse immdiate dans les premiers coups
+    NeuralNet evalNet;          // Rseau d'valuation (facultatif) : corrige la diffrence de magasins de l'alpha-beta
+    SearchResult lastSearch; // Dernire rflexion reue (PV mise  jour  chaque itration)
+    BoardT lastSearchRoot;   // Position d'o part lastSearch.pv
+    MctsArena mctsArena;     // Noeuds du MCTS, allous une fois et recycls  chaque coup
+    AIWorker<BoardT> aiWorker; // Thread de rflexion : dclar aprs la table, la base et l'arne qu'il utilise
+    HintWorker<BoardT> hints;  // Conseils : score de chaque coup, calcul en continu (dclar aprs la base)
+    bool showHints;            // Trous jouables teints selon leur score
+    HintScores<BoardT> hintScores; // Derniers scores reus
+    uint32_t aiJob;          // Rflexion attendue (0 = aucune)
+    uint64_t aiJobKey;       // Position sur laquelle elle porte
+    BoardT aiJobRoot;
+    bool aiJobPonder;        // Lance sur le temps de l'humain, sans chance
+    bool aiMoveReady;        // Coup reu, jou aprs aiDelay
+    int aiMove;
+    uint64_t aiMoveKey;
+    std::string aiMoveInfo;
+    float aiDelay;           // Petite pause avant de jouer, pour laisser voir le coup prcdent
+    float aiWait;
+
+    // --- PARTIE EN RESEAU (client du serveur de parties) ---
+    bool remoteMode;         // Le serveur arbitre : la fentre envoie les clics et anime ses MSG_EVENTS
+    bool remoteVsAI;         // Adversaire demand : l'ordinateur du serveur (sinon un autre client)
+    NetClient remote;
+    int remoteSeat;          // Place attribue par le serveur (-1 : pas de partie en cours)
+    bool remoteMoveSent;     // Coup envoy, en attente de son droulement
+    std::deque<MoveEventStream<BoardT>> remoteQueue; // Coups reus pendant une animation
+
+    BasicMancalaGame() : aiWorker(aiTable, endgame, mctsArena), hints(endgame) {
+        aiPlays[0] = false;
+        aiPlays[1] = true;
+        aiEngine = ENGINE_ALPHABETA;
+        aiLimits.timeLimitMs = 100;
+        aiPonder = true;
+        aiTable.Resize(16);
+        aiJob = 0;
+        aiJobPonder = false;
+        aiMoveReady = false;
+        aiDelay = 0.4f;
+        remoteMode = false;
+        remoteVsAI = false;
+        remoteSeat = -1;
+        remoteMoveSent = false;
+        showHints = false;
         InitBoard();
     }
 
-    // Initialisation du plateau (4 graines partout, magasins vides)
+    ~BasicMancalaGame() {
+        if (!gameOver) RecordGame(false); // Fentre ferme en cours de partie
+    }
+
+    // Initialisation du plateau (SEEDS_PER_PIT graines partout, magasins vides)
     void InitBoard() {
         pits.clear();
+        board = BoardT::Initial();
+        position = board;
+        history.Clear();
+        StopAI();
+        aiMoveReady = false;
         state = IDLE;
-        currentPlayer = 0;
         gameOver = false;
+        aiWait = 0.0f;
         moveSpeed = 3.5f; // Vitesse de l'animation
         statusMessage = "Jeu pret. Tour du Joueur 1 (Bas)";
 
-        // --- JOUEUR 1 (Bas) : Trous 0  5 ---
-        for(int i = 0; i < 6; i++) {
-            Pit p; p.id = i; p.seeds = 4;
-            p.position = glm::vec3((i - 2.5f) * 2.2f, 0.0f, 1.8f);
+        float halfRow = (N - 1) / 2.0f; // 2.5 pour 6 trous
+
+        // --- JOUEUR 1 (Bas) : Trous 0  N-1 ---
+        for(int i = 0; i < N; i++) {
+            Pit p; p.id = i;
+            p.position = glm::vec3((i - halfRow) * 2.2f, 0.0f, 1.8f);
             p.radius = 0.8f; p.isSelected = false; p.isHovered = false; p.isHidden = false; p.isActive = true;
             pits.push_back(p);
         }
 
-        // --- MAGASIN J1 (Droite) : Trou 6 ---
-        Pit store1; store1.id = 6; store1.seeds = 0;
-        store1.position = glm::vec3(7.5f, 0.0f, 0.0f);
+        // --- MAGASIN J1 (Droite) : Trou N ---
+        Pit store1; store1.id = BoardT::STORE_P1;
+        store1.position = glm::vec3(halfRow * 2.2f + 2.0f, 0.0f, 0.0f);
         store1.radius = 1.3f; store1.isSelected = false; store1.isHovered = false; store1.isHidden = false; store1.isActive = false;
         pits.push_back(store1);
 
-        // --- JOUEUR 2 (Haut) : Trous 7  12 ---
-        for(int i = 0; i < 6; i++) {
-            Pit p; p.id = 7 + i; p.seeds = 4;
+        // --- JOUEUR 2 (Haut) : Trous N+1  2N ---
+        for(int i = 0; i < N; i++) {
+            Pit p; p.id = BoardT::STORE_P1 + 1 + i;
             // Position inverse pour tre en face
-            p.position = glm::vec3((2.5f - i) * 2.2f, 0.0f, -1.8f);
+            p.position = glm::vec3((halfRow - i) * 2.2f, 0.0f, -1.8f);
             p.radius = 0.8f; p.isSelected = false; p.isHovered = false; p.isHidden = false; p.isActive = false;
             pits.push_back(p);
         }
 
-        // --- MAGASIN J2 (Gauche) : Trou 13 ---
-        Pit store2; store2.id = 13; store2.seeds = 0;
-        store2.position = glm::vec3(-7.5f, 0.0f, 0.0f);
+        // --- MAGASIN J2 (Gauche) : Trou 2N+1 ---
+        Pit store2; store2.id = BoardT::STORE_P2;
+        store2.position = glm::vec3(-(halfRow * 2.2f + 2.0f), 0.0f, 0.0f);
         store2.radius = 1.3f; store2.isSelected = false; store2.isHovered = false; store2.isHidden = false; store2.isActive = false;
         pits.push_back(store2);
 
         UpdateActivePits();
         PrintGameState();
+        if (showHints) hints.SetRoot(position);
     }
 
     void PrintGameState() {
-        std::cout << "J1: " << pits[6].seeds << " | J2: " << pits[13].seeds << std::endl;
+        std::cout << "J1: " << (int)board.seeds[BoardT::STORE_P1] << " | J2: " << (int)board.seeds[BoardT::STORE_P2] << std::endl;
     }
 
     // Active/Dsactive la surbrillance des trous selon le tour
     void UpdateActivePits() {
+        bool humanTurn = remoteMode ? board.sideToMove == remoteSeat && !remoteMoveSent && remote.IsConnected()
+                                    : !aiPlays[board.sideToMove];
         for(auto& p : pits) {
-            p.isActive = false;
-            // Joueur 1 joue sur 0-5
-            if (currentPlayer == 0 && p.id >= 0 && p.id <= 5 && p.seeds > 0) p.isActive = true;
-            // Joueur 2 joue sur 7-12
-            if (currentPlayer == 1 && p.id >= 7 && p.id <= 12 && p.seeds > 0) p.isActive = true;
+            // Trous jouables du joueur au trait (0-5 pour J1, 7-12 pour J2 au Kalah) ; rien  cliquer quand l'ordinateur joue
+            p.isActive = humanTurn && IsLegalMove(board, p.id);
+        }
+    }
+
+    // --- CONSEILS ---
+    void SetHints(bool enabled) {
+        showHints = enabled;
+        hintScores = HintScores<BoardT>();
+        if (enabled) hints.SetRoot(position);
+        else hints.Clear();
+    }
+
+    // Qualit du coup 'pit' dans la position affiche : 1 = meilleur coup,
+    // 0 = au moins HINT_SPREAD graines de moins. false si pas (encore) de conseil.
+    static constexpr float HINT_SPREAD = 8.0f;
+    bool HintQuality(int pit, float& quality) const {
+        if (!showHints || state != IDLE || hintScores.depth == 0 || hintScores.key != HashPosition(board)) return false;
+        int best = -SCORE_INF, score = -SCORE_INF;
+        for (int i = 0; i < hintScores.count; i++) {
+            if (hintScores.scores[i] > best) best = hintScores.scores[i];
+            if (hintScores.moves[i] == pit) score = hintScores.scores[i];
+        }
+        if (score == -SCORE_INF) return false;
+        float loss = (float)(best - score) / HINT_SPREAD;
+        quality = loss >= 1.0f ? 0.0f : 1.0f - loss;
+        return true;
+    }
+
+    // Confie (ou rend) un joueur  l'ordinateur
+    void SetAIPlayer(int player, bool enabled) {
+        if (remoteMode) return; // En rseau, l'adversaire est choisi par le serveur
+        aiPlays[player] = enabled;
+        aiWait = 0.0f;
+        StopAI();
+        aiMoveReady = false;
+        if (state == IDLE && !gameOver) UpdateActivePits();
+    }
+
+    void SetAIEngine(AIEngine engine) {
+        aiEngine = engine;
+        StopAI();
+        aiMoveReady = false;
+    }
+
+    // --- REFLEXION EN ARRIERE-PLAN ---
+    // Appel ds qu'un coup est lanc, avec la position qui suivra : l'ordinateur au
+    // trait cherche pendant l'animation ; l'humain au trait, il rflchit sur la
+    // rponse que sa PV prvoit. Si l'humain joue ce coup-l, la rflexion continue.
+    void PlanAI(const BoardT& next) {
+        aiMoveReady = false;
+        if (IsTerminal(next) || (!aiPlays[0] && !aiPlays[1])) { StopAI(); return; }
+        uint64_t key = HashPosition(next);
+
+        if (aiPlays[next.sideToMove]) {
+            if (aiJob != 0 && aiJobKey == key) {
+                if (aiJobPonder) {
+                    aiWorker.PonderHit(aiJob);
+                    aiJobPonder = false;
+                    std::cout << "IA : coup prevu, la reflexion continue" << std::endl;
+                }
+                return;
+            }
+            BookEntry entry;
+            if (aiEngine == ENGINE_ALPHABETA && ProbeBook(book, next, entry)) {
+                StopAI();
+                lastSearch = SearchResult();
+                lastSearch.bestMove = entry.move;
+                lastSearch.score = entry.score;
+                lastSearch.depth = entry.depth;
+                lastSearch.pv[0] = entry.move;
+                lastSearch.pvLength = 1;
+                lastSearchRoot = next;
+                SetAIMove(next, entry.move, " (livre, profondeur " + std::to_string(entry.depth) + ", score " + FormatScore(entry.score) + ")");
+                return;
+            }
+            StartAI(next, false);
+            return;
+        }
+
+        // Humain au trait
+        if (!aiPonder || aiEngine != ENGINE_ALPHABETA || !aiPlays[1 - next.sideToMove]) { StopAI(); return; }
+        BoardT predicted;
+        if (PredictReply(next, predicted)) {
+            if (aiJob != 0 && aiJobPonder && aiJobKey == HashPosition(predicted)) return; // Toujours sur la ligne prvue
+            StartAI(predicted, true);
+        } else {
+            StartAI(next, true); // Pas de prvision : on remplit au moins la table de transposition
+        }
+    }
+
+    // Position o l'ordinateur rejouera si l'humain suit la PV de la dernire rflexion
+    bool PredictReply(const BoardT& from, BoardT& predicted) const {
+        BoardT b = lastSearchRoot;
+        uint64_t key = HashPosition(from);
+        bool reached = HashPosition(b) == key;
+        for (int i = 0; i < lastSearch.pvLength && !IsTerminal(b); i++) {
+            if (reached && aiPlays[b.sideToMove]) break;
+            if (!IsLegalMove(b, lastSearch.pv[i])) return false;
+            ApplyMove(b, lastSearch.pv[i]);
+            if (!reached) reached = HashPosition(b) == key;
+        }
+        if (!reached || IsTerminal(b) || !aiPlays[b.sideToMove]) return false;
+        predicted = b;
+        return true;
+    }
+
+    void StartAI(const BoardT& root, bool ponder) {
+        SearchLimits limits = aiLimits;
+        limits.ponder = ponder;
+        aiJob = aiWorker.Think(root, limits, aiEngine);
+        aiJobKey = HashPosition(root);
+        aiJobRoot = root;
+        aiJobPonder = ponder;
+    }
+
+    void StopAI() {
+        if (aiJob != 0) aiWorker.Cancel();
+        aiJob = 0;
+        aiJobPonder = false;
+    }
+
+    void SetAIMove(const BoardT& root, int move, const std::string& info) {
+        aiMoveReady = true;
+        aiMove = move;
+        aiMoveKey = HashPosition(root);
+        aiMoveInfo = "IA J" + std::to_string(root.sideToMove + 1) + " : trou " + std::to_string(move) + info;
+    }
+
+    // Relve les messages du thread de rflexion (jamais bloquant)
+    void PollAI() {
+        AIMessage msg;
+        while (aiWorker.Poll(msg)) {
+            if (msg.job != aiJob) continue; // Rflexion abandonne entre-temps
+            lastSearch = msg.result;
+            lastSearchRoot = aiJobRoot;
+            if (msg.type != AI_BEST_MOVE) continue;
+
+            aiJob = 0;
+            if (msg.result.bestMove < 0) continue;
+            if (msg.engine == ENGINE_MCTS) {
+                SetAIMove(aiJobRoot, msg.result.bestMove, " (MCTS, " + std::to_string((int)(msg.winRate * 100.0 + 0.5)) + " % de gain, "
+                          + std::to_string(msg.playouts) + " playouts, " + std::to_string(msg.result.nodes) + " noeuds)");
+            } else {
+                SetAIMove(aiJobRoot, msg.result.bestMove, " (profondeur " + std::to_string(msg.result.depth) + ", score "
+                          + FormatScore(msg.result.score) + ", " + std::to_string(msg.result.nodes) + " noeuds)");
+            }
+        }
+    }
+
+    // Lance le coup reu comme un clic
+    void PlayAIMove() {
+        aiMoveReady = false;
+        if (!IsLegalMove(board, aiMove)) return;
+        std::cout << aiMoveInfo << std::endl;
+        TryPlayMove(aiMove);
+    }
+
+    // Rseau d'valuation (gnr par : mancala-headless train), pris par l'alpha-beta
+    // s'il a t entran sur cette variante
+    bool OpenNet(const std::string& path) {
+        if (!evalNet.Open(path)) return false;
+        if (!evalNet.IsFor<BoardT>()) {
+            std::cerr << "Reseau entraine pour une autre variante : " << path << std::endl;
+            evalNet.Close();
+            return false;
+        }
+        aiLimits.net = &evalNet;
+        return true;
+    }
+
+    // --- PARTIE EN RESEAU ---
+    // Le serveur (mancala-headless server) tient la partie : un clic devient un
+    // MSG_MOVE, et chaque coup revient en MSG_EVENTS, anim exactement comme un
+    // coup local. Ni ordinateur local ni retour en arrire pendant une partie en ligne.
+    bool ConnectRemote(const std::string& address, bool vsServerAI) {
+        if (!remote.Connect(address)) return false;
+        for (int p = 0; p < 2; p++) aiPlays[p] = false;
+        remoteMode = true;
+        remoteVsAI = vsServerAI;
+        std::cout << "Connecte au serveur " << address << std::endl;
+        JoinRemote();
+        return true;
+    }
+
+    bool IsRemote() const { return remoteMode; }
+
+    // Demande une nouvelle partie au serveur (au lancement, puis aprs chaque fin de partie)
+    void JoinRemote() {
+        if (!remoteMode || remoteSeat >= 0) return;
+        InitBoard();
+        for (auto& p : pits) p.isActive = false;
+        uint8_t opponent = remoteVsAI ? NET_OPPONENT_AI : NET_OPPONENT_CLIENT;
+        if (!remote.Send(MSG_JOIN, &opponent, 1)) { statusMessage = "Connexion au serveur perdue"; return; }
+        statusMessage = remoteVsAI ? "En ligne : partie contre l'ordinateur du serveur..." : "En ligne : en attente d'un adversaire...";
+    }
+
+    // Fin de la partie en ligne : connexion perdue, ou coupe si le serveur n'est pas cohrent
+    void DropRemote(const std::string& message) {
+        remote.Close();
+        if (remoteSeat >= 0 && !gameOver) RecordGame(false);
+        remoteSeat = -1;
+        gameOver = true;
+        statusMessage = message;
+        for (auto& p : pits) p.isActive = false;
+        remoteMode = false; // Plus rien  jouer : la partie en ligne s'arrte l
+        remoteQueue.clear();
+    }
+
+    // Relve les messages du serveur (jamais bloquant)
+    void PollRemote() {
+        if (!remoteMode) return;
+        if (!remote.Poll()) {
+            DropRemote("Connexion au serveur perdue");
+            return;
+        }
+        NetMessage m;
+        while (remote.NextMessage(m)) {
+            switch (m.type) {
+            case MSG_MATCH: {
+                uint32_t id;
+                int seat, opponent;
+                BoardT start;
+                if (!DecodeMatchFrame(m, id, seat, opponent, start)) break;
+                InitBoard();
+                board = position = start;
+                if (showHints) hints.SetRoot(position);
+                remoteSeat = seat;
+                remoteMoveSent = false;
+                remoteQueue.clear();
+                statusMessage = "Partie " + std::to_string(id) + " : vous etes le Joueur " + (seat == 0 ? "1 (Bas)" : "2 (Haut)")
+                              + (opponent == NET_OPPONENT_AI ? " contre l'ordinateur du serveur" : "");
+                UpdateActivePits();
+                break;
+            }
+            case MSG_EVENTS:
+                remoteQueue.emplace_back();
+                if (!DecodeEventsFrame(m, remoteQueue.back())) {
+                    std::cout << "Serveur : deroulement de coup invalide" << std::endl;
+                    DropRemote("Serveur incoherent : connexion coupee");
+                    return;
+                }
+                break;
+            case MSG_OPPONENT_LEFT:
+                FinishAnimation(); // Le coup en cours est pos tel quel, aucune graine ne reste en l'air
+                remoteQueue.clear();
+                if (gameOver) break; // Ce coup terminait dj la partie
+                RecordGame(false);
+                remoteSeat = -1;
+                gameOver = true;
+                statusMessage = "L'adversaire a quitte la partie | (N) Nouvelle partie";
+                for (auto& p : pits) p.isActive = false;
+                break;
+            case MSG_ERROR:
+                std::cout << "Serveur : coup refuse (erreur " << (m.size > 0 ? (int)m.payload[0] : -1) << ")" << std::endl;
+                remoteMoveSent = false;
+                if (state == IDLE && !gameOver) UpdateActivePits();
+                break;
+            }
+        }
+        // Un coup  la fois : le suivant attend la fin de l'animation en cours
+        if (state == IDLE && !remoteQueue.empty()) {
+            moveEvents = remoteQueue.front();
+            remoteQueue.pop_front();
+            // Le serveur n'est pas cru sur parole : le coup est rejou ici et
+            // son droulement doit tre celui reu, vnement par vnement
+            int pit = moveEvents.events[0].pit;
+            BoardT after = board;
+            MoveEventStream<BoardT> expected;
+            bool legal = IsLegalMove(board, pit);
+            if (legal) RecordMove(after, pit, expected);
+            if (!legal || !SameEvents(expected, moveEvents)) {
+                std::cout << "Serveur : coup " << pit << " incoherent avec le plateau affiche" << std::endl;
+                DropRemote("Serveur incoherent : connexion coupee");
+                return;
+            }
+            if (board.sideToMove == remoteSeat) remoteMoveSent = false;
+            AnimateMove(pit);
         }
     }
 
     // Boucle de mise  jour (Animation)
     void Update(float deltaTime) {
+        PollAI();
+        PollRemote();
+        if (showHints) hints.Poll(hintScores);
+        if (state == IDLE && !gameOver && aiPlays[board.sideToMove] && !IsReviewing()) {
+            aiWait += deltaTime;
+            uint64_t key = HashPosition(board);
+            bool thinking = aiJob != 0 && aiJobKey == key && !aiJobPonder;
+            bool ready = aiMoveReady && aiMoveKey == key;
+            if (!thinking && !ready) PlanAI(board); // Rien en cours pour cette position (IA active en cours de partie...)
+            if (ready && aiWait >= aiDelay) {
+                aiWait = 0.0f;
+                PlayAIMove();
+            }
+        }
+
         if (state == ANIMATING) {
             activeSeed.progress += deltaTime * moveSpeed;
             // Courbe parabolique pour le saut
@@ -118,21 +489,20 @@ public:
             // Fin du mouvement d'une graine
             if (activeSeed.progress >= 1.0f) {
                 int targetIdx = activeSeed.targetPitIndex;
-                pits[targetIdx].seeds++; // Ajouter la graine au trou cible
+                board.seeds[targetIdx]++; // Ajouter la graine au trou cible
 
-                if (!pathQueue.empty()) {
+                if (!eventCursor.Done() && eventCursor.Peek().type == EV_SEED_DROPPED) {
                     StartNextSeedAnimation();
                 } else {
-                    OnMoveFinished(targetIdx);
+                    OnMoveFinished();
                 }
             }
         }
     }
 
     void StartNextSeedAnimation() {
-        if (pathQueue.empty()) return;
-        int nextPitId = pathQueue.front();
-        pathQueue.erase(pathQueue.begin());
+        if (eventCursor.Done() || eventCursor.Peek().type != EV_SEED_DROPPED) return;
+        int nextPitId = eventCursor.Next().pit;
         activeSeed.startPos = activeSeed.endPos; // Part de la o la prcdente s'est arrte (visuellement fluide)
         activeSeed.targetPitIndex = nextPitId;
         activeSeed.endPos = pits[nextPitId].position;
@@ -176,128 +546,166 @@ public:
 
     // Initialise le coup
     void TryPlayMove(int pitIndex) {
-        // Scurit : Vrifier que le joueur joue du bon ct
-        if (currentPlayer == 0 && (pitIndex < 0 || pitIndex > 5)) return;
-        if (currentPlayer == 1 && (pitIndex < 7 || pitIndex > 12)) return;
-
-        seedsInHand = pits[pitIndex].seeds;
-        pits[pitIndex].seeds = 0; // On vide le trou cliqu
-
-        // Calculer le chemin
-        pathQueue.clear();
-        int currentIndex = pitIndex;
+        // Scurit : Vrifier que le joueur joue du bon ct (et un trou non vide)
+        if (!IsLegalMove(board, pitIndex)) return;
+
+        // En rseau, le coup part au serveur : on l'animera quand il reviendra
+        if (remoteMode) {
+            if (board.sideToMove != remoteSeat || remoteMoveSent) return;
+            uint8_t pit = (uint8_t)pitIndex;
+            remoteMoveSent = remote.Send(MSG_MOVE, &pit, 1);
+            for (auto& p : pits) p.isActive = false;
+            return;
+        }
 
-        for (int i = 0; i < seedsInHand; i++) {
-            currentIndex = (currentIndex + 1) % 14;
+        // Les rgles sont appliques sur une copie, l'animation rejoue ensuite le flux d'vnements
+        BoardT after = board;
+        RecordMove(after, pitIndex, moveEvents);
+        AnimateMove(pitIndex);
+        PlanAI(after); // La rflexion sur la suite commence pendant l'animation
+    }
 
-            // Sauter le magasin adverse
-            if (currentPlayer == 0 && currentIndex == 13) currentIndex = 0;
-            else if (currentPlayer == 1 && currentIndex == 6) currentIndex = 7;
+    // Anime le coup dcrit par moveEvents (jou ici ou reu du serveur)
+    void AnimateMove(int pitIndex) {
+        eventCursor = ReadEvents(moveEvents);
+        history.Play(position, pitIndex); // Oublie les coups annuls aprs celui-ci
+        if (showHints) hints.SetRoot(position); // Sous-arbre du coup gard : conseils prts ds la fin de l'animation
 
-            pathQueue.push_back(currentIndex);
-        }
+        board.seeds[eventCursor.Next().pit] = 0; // EV_PICKUP : On vide le trou cliqu
 
         // Dmarrer l'animation
         state = ANIMATING;
         statusMessage = "Distribution...";
 
-        activeSeed.startPos = pits[pitIndex].position;
-        int firstTarget = pathQueue.front();
-        pathQueue.erase(pathQueue.begin());
-        activeSeed.targetPitIndex = firstTarget;
-        activeSeed.endPos = pits[firstTarget].position;
-        activeSeed.progress = 0.0f;
+        activeSeed.endPos = pits[pitIndex].position; // Point de dpart de la premire graine
+        StartNextSeedAnimation();
 
         // Dsactiver les clics pendant l'anim
         for(auto& p : pits) p.isActive = false;
     }
 
-    // Appel quand la dernire graine tombe
-    void OnMoveFinished(int lastPitIdx) {
+    // Termine sans attendre l'animation en cours : graines restantes dposes, fin du flux lue
+    void FinishAnimation() {
+        if (state != ANIMATING) return;
+        board.seeds[activeSeed.targetPitIndex]++;
+        while (!eventCursor.Done() && eventCursor.Peek().type == EV_SEED_DROPPED) board.seeds[eventCursor.Next().pit]++;
+        OnMoveFinished();
+    }
+
+    // Appel quand la dernire graine tombe : on lit la fin du flux
+    void OnMoveFinished() {
         state = IDLE;
-        bool switchTurn = true;
-
-        // REGLE : REJOUER si on finit dans son magasin
-        if (currentPlayer == 0 && lastPitIdx == 6) {
-            statusMessage = ">>> JOUEUR 1 REJOUE ! (Derniere au magasin)";
-            switchTurn = false;
-        } else if (currentPlayer == 1 && lastPitIdx == 13) {
-            statusMessage = ">>> JOUEUR 2 REJOUE ! (Derniere au magasin)";
-            switchTurn = false;
-        }
-        // REGLE : CAPTURE si on finit dans un trou vide de son ct
-        else if (pits[lastPitIdx].seeds == 1) { // == 1 car on vient de la poser
-            bool isMySide = false;
-            if (currentPlayer == 0 && lastPitIdx >= 0 && lastPitIdx <= 5) isMySide = true;
-            if (currentPlayer == 1 && lastPitIdx >= 7 && lastPitIdx <= 12) isMySide = true;
-
-            if (isMySide) {
-                int oppositeIdx = 12 - lastPitIdx; // Formule symtrique
-                if (pits[oppositeIdx].seeds > 0) {
-                    int captured = pits[oppositeIdx].seeds + 1; // +1 pour celle qu'on vient de poser
-                    pits[oppositeIdx].seeds = 0;
-                    pits[lastPitIdx].seeds = 0;
-
-                    int myStore = (currentPlayer == 0) ? 6 : 13;
-                    pits[myStore].seeds += captured;
-
-                    statusMessage = "CAPTURE ! + " + std::to_string(captured);
+        int captured = 0;
+
+        while (!eventCursor.Done()) {
+            const MoveEvent& e = eventCursor.Next();
+            switch (e.type) {
+            // REGLE : CAPTURE si on finit dans un trou vide de son ct
+            case EV_CAPTURE:
+                board.seeds[e.pit] = 0;
+                board.seeds[e.target] += e.amount;
+                captured += e.amount;
+                statusMessage = "CAPTURE ! + " + std::to_string(captured);
+                break;
+            // REGLE : REJOUER si on finit dans son magasin
+            case EV_EXTRA_TURN:
+                statusMessage = (e.pit == 0) ? ">>> JOUEUR 1 REJOUE ! (Derniere au magasin)" : ">>> JOUEUR 2 REJOUE ! (Derniere au magasin)";
+                break;
+            case EV_TURN_PASSED:
+                board.sideToMove = e.pit;
+                statusMessage = (e.pit == 0) ? "Tour du Joueur 1 (Bas)" : "Tour du Joueur 2 (Haut)";
+                break;
+            // --- NETTOYAGE DU PLATEAU : ce qui reste dans un camp va dans son magasin ---
+            case EV_SWEEP:
+                for (int i = BoardT::FirstPitOf(e.pit); i < BoardT::FirstPitOf(e.pit) + N; i++) board.seeds[i] = 0;
+                board.seeds[BoardT::StoreOf(e.pit)] += e.amount;
+                break;
+            case EV_GAME_OVER:
+                CheckGameOver();
+                RecordGame(true);
+                if (remoteMode) {
+                    remoteSeat = -1;
+                    statusMessage += " | (N) Nouvelle partie";
                 }
+                break;
             }
         }
 
-        // Vrifier si la partie est finie
-        CheckGameOver();
-
         if (!gameOver) {
-            if (switchTurn) {
-                currentPlayer = 1 - currentPlayer;
-                statusMessage = (currentPlayer == 0) ? "Tour du Joueur 1 (Bas)" : "Tour du Joueur 2 (Haut)";
-            }
+            CheckGameOver(); // Pas encore finie : la base de finales peut dj en donner l'issue
             UpdateActivePits();
             PrintGameState();
         }
     }
 
-    // --- C'EST ICI QUE SE JOUE LA FIN DE PARTIE ---
-    void CheckGameOver() {
-        bool p1Empty = true;
-        bool p2Empty = true;
+    // --- HISTORIQUE : ANNULER / REFAIRE / ALLER A UN COUP ---
+    // Chaque saut dfait ou rejoue les coups un par un (MakeMove / UnmakeMove),
+    // sans rejouer la partie depuis le dbut. Une animation en cours est coupe.
+    // Tant qu'on n'est pas revenu au dernier coup, l'ordinateur ne joue pas :
+    // on peut parcourir la partie ; jouer un coup en efface la suite.
 
-        // Vrification J1 (Indices 0  5)
-        for(int i=0; i<6; i++) {
-            if(pits[i].seeds > 0) p1Empty = false;
-        }
+    bool IsReviewing() const { return history.Ply() < history.Length(); }
 
-        // Vrification J2 (Indices 7  12)
-        // ATTENTION : i <= 12 est crucial pour inclure le dernier trou
-        for(int i=7; i<=12; i++) {
-            if(pits[i].seeds > 0) p2Empty = false;
-        }
+    // Annule jusqu'au dernier coup d'un humain (un seul demi-coup si personne ne joue)
+    bool Undo() {
+        int target = history.Ply() - 1;
+        bool human = !aiPlays[0] || !aiPlays[1];
+        while (human && target > 0 && aiPlays[history[target].side]) target--;
+        return JumpToPly(target);
+    }
 
-        if (p1Empty || p2Empty) {
-            gameOver = true;
+    bool Redo() { return JumpToPly(history.Ply() + 1); }
 
-            // --- NETTOYAGE DU PLATEAU (UPDATE VISUEL) ---
+    bool JumpToPly(int ply) {
+        if (remoteMode) return false; // Le serveur tient la partie
+        if (ply < 0 || ply > history.Length()) return false;
+        if (ply == history.Ply() && state == IDLE) return false;
+        history.JumpTo(position, ply);
 
-            // 1. Tout ce qui reste chez J1 va dans le magasin J1
-            for(int i=0; i<6; i++) {
-                pits[6].seeds += pits[i].seeds;
-                pits[i].seeds = 0; // IMPORTANT : Met  0 pour que le rendu 3D ne les affiche plus
-            }
+        StopAI();
+        aiMoveReady = false;
+        aiWait = 0.0f;
+        state = IDLE;
+        gameOver = false;
+        board = position;
+        if (showHints) hints.SetRoot(position);
+        statusMessage = "Coup " + std::to_string(ply) + "/" + std::to_string(history.Length()) + " : Tour du Joueur "
+                        + (board.sideToMove == 0 ? "1 (Bas)" : "2 (Haut)");
+        CheckGameOver();
+        if (!gameOver) UpdateActivePits();
+        PrintGameState();
+        return true;
+    }
 
-            // 2. Tout ce qui reste chez J2 va dans le magasin J2
-            for(int i=7; i<=12; i++) {
-                pits[13].seeds += pits[i].seeds;
-                pits[i].seeds = 0; // IMPORTANT : Met  0 pour le rendu 3D
+    // Ajoute  l'archive les coups jous jusqu' la position courante
+    void RecordGame(bool finished) {
+        int count = history.Ply();
+        if (!recorder.IsOpen() || count == 0) return;
+        std::vector<uint8_t> moves(count);
+        for (int i = 0; i < count; i++) moves[i] = history[i].pit;
+        GameRecordHeader h = MakeGameRecordHeader(position, count, finished);
+        for (int p = 0; p < 2; p++) {
+            h.players[p] = !aiPlays[p] ? PLAYER_HUMAN : (aiEngine == ENGINE_MCTS ? PLAYER_MCTS : PLAYER_ALPHABETA);
+            if (aiPlays[p]) {
+                h.levels[p] = aiLimits.timeLimitMs;
+                h.flags |= p == 0 ? RECORD_P1_TIMED : RECORD_P2_TIMED;
             }
+        }
+        recorder.Write(h, moves.data());
+    }
+
+    // --- C'EST ICI QUE SE JOUE LA FIN DE PARTIE ---
+    void CheckGameOver() {
+        if (IsTerminal(board)) {
+            gameOver = true;
 
             // --- VAINQUEUR ---
             std::string winner;
-            if (pits[6].seeds > pits[13].seeds) {
+            int w = Winner(board);
+            if (w == 0) {
                 winner = "VICTOIRE JOUEUR 1 !";
             }
-            else if (pits[13].seeds > pits[6].seeds) {
+            else if (w == 1) {
                 winner = "VICTOIRE JOUEUR 2 !";
             }
             else {
@@ -305,11 +713,22 @@ public:
             }
 
             // Mise  jour du message final
-            statusMessage = "FIN : " + winner + " [J1:" + std::to_string(pits[6].seeds) + " - J2:" + std::to_string(pits[13].seeds) + "]";
+            statusMessage = "FIN : " + winner + " [J1:" + std::to_string(board.seeds[BoardT::STORE_P1]) + " - J2:" + std::to_string(board.seeds[BoardT::STORE_P2]) + "]";
 
             // Dsactiver toutes les lumires d'interaction
             for(auto& p : pits) p.isActive = false;
         }
+        else {
+            // --- ISSUE CONNUE (base de finales) : score final en jeu parfait ---
+            int margin;
+            if (ProbeFinalMargin(endgame, board, margin)) {
+                int mine = (BoardT::TOTAL_SEEDS + margin) / 2; // Magasin final du joueur au trait
+                int final1 = (board.sideToMove == 0) ? mine : BoardT::TOTAL_SEEDS - mine;
+                int final2 = BoardT::TOTAL_SEEDS - final1;
+                std::string outcome = (final1 > final2) ? "J1 gagne" : (final2 > final1) ? "J2 gagne" : "egalite";
+                statusMessage += " | Finale : " + outcome + " " + std::to_string(final1) + "-" + std::to_string(final2) + " en jeu parfait";
+            }
+        }
     }
 
     void UpdateHover(glm::vec3 rayOrigin, glm::vec3 rayDir, bool isEditMode) {
@@ -339,4 +758,6 @@ public:
         }
     }
 };
+
+typedef BasicMancalaGame<Kalah6x4> MancalaGame; // Le plateau de la fenetre 3D
 #endif
@@ -0,0 +1,246 @@
+#ifndef MCTS_HPP
+#define MCTS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Board.hpp"
+#include "BoardSimd.hpp"
+#include "Rng.hpp"
+
+// Monte Carlo Tree Search (UCT) sur le plateau compact, sans fonction d'evaluation :
+// les parties aleatoires (playouts) jouees jusqu'au bout tiennent lieu de jugement.
+// Parallelisme d'arbre : tous les threads descendent le meme arbre ; une "perte
+// virtuelle" posee sur le chemin en cours detourne les autres threads vers
+// d'autres branches jusqu'a la remontee du resultat.
+
+enum MctsNodeState : uint8_t {
+    NODE_LEAF,      // Enfants pas encore crees
+    NODE_EXPANDING, // Un thread est en train de les creer
+    NODE_EXPANDED
+};
+
+struct MctsNode {
+    std::atomic<uint32_t> visits;
+    std::atomic<uint32_t> halfPoints;  // 2 par victoire, 1 par nulle, du point de vue de 'mover'
+    std::atomic<int32_t> virtualLoss;  // Descentes en cours a travers ce noeud
+    std::atomic<uint8_t> state;
+    int8_t move;                       // Coup qui mene a ce noeud
+    uint8_t mover;                     // Joueur qui a joue ce coup
+    uint8_t childCount;
+    MctsNode* children;                // Bloc contigu dans l'arene
+
+    void Init(int m, int who) {
+        visits.store(0, std::memory_order_relaxed);
+        halfPoints.store(0, std::memory_order_relaxed);
+        virtualLoss.store(0, std::memory_order_relaxed);
+        state.store(NODE_LEAF, std::memory_order_relaxed);
+        move = (int8_t)m;
+        mover = (uint8_t)who;
+        childCount = 0;
+        children = nullptr;
+    }
+};
+
+// Arene de noeuds : une seule allocation, distribuee par blocs sans verrou,
+// liberee d'un coup (Reset) a la recherche suivante. Aucun new par noeud.
+class MctsArena {
+public:
+    explicit MctsArena(size_t capacity = 1 << 20) : nodes(new MctsNode[capacity]), capacity(capacity), used(0) {}
+
+    void Reset() { used.store(0, std::memory_order_relaxed); }
+
+    // nullptr si l'arene est pleine (l'arbre arrete alors de grandir)
+    MctsNode* Allocate(int count) {
+        size_t first = used.fetch_add((size_t)count, std::memory_order_relaxed);
+        if (first + count > capacity) return nullptr;
+        return &nodes[first];
+    }
+
+    size_t Used() const {
+        size_t u = used.load(std::memory_order_relaxed);
+        return u < capacity ? u : capacity;
+    }
+    size_t Capacity() const { return capacity; }
+
+private:
+    std::unique_ptr<MctsNode[]> nodes;
+    size_t capacity;
+    std::atomic<size_t> used;
+};
+
+struct MctsLimits {
+    int timeLimitMs = 0;        // Limite de temps (0 = aucune)
+    long iterations = 0;        // Limite de playouts (0 = aucune ; au moins une des deux)
+    int threads = 1;            // 0 = tous les coeurs
+    double exploration = 1.0;   // Constante C de l'UCT
+    int maxPlayoutPlies = 300;  // Garde-fou pour l'Oware (partie ramassee au-dela)
+    uint64_t seed = 1;
+    const std::atomic<bool>* stop = nullptr; // Optionnel : annulation depuis un autre thread
+};
+
+const int MCTS_MAX_PATH = 512;
+
+struct MctsResult {
+    int bestMove = -1;          // Enfant de la racine le plus visite
+    double winRate = 0.5;       // Score moyen de ce coup (1 = victoire)
+    long iterations = 0;
+    size_t nodes = 0;
+    double seconds = 0.0;
+    int pv[64];                 // Suite des enfants les plus visites
+    int pvLength = 0;
+};
+
+// Partie aleatoire jusqu'au bout, renvoie le vainqueur (-1 = egalite).
+// Passe par la distribution vectorielle (lot d'une partie).
+template <class B>
+int MctsPlayout(const B& b, Rng& rng, int maxPlies) {
+    PlayoutOutcome outcome;
+    BatchPlayouts(b, 1, rng, maxPlies, &outcome);
+    return outcome.winner;
+}
+
+// Enfant au meilleur score UCT ; la perte virtuelle compte comme des visites perdues
+inline MctsNode* MctsSelect(MctsNode* node, double exploration) {
+    uint32_t parentVisits = node->visits.load(std::memory_order_relaxed) + node->virtualLoss.load(std::memory_order_relaxed);
+    double logParent = std::log((double)(parentVisits > 0 ? parentVisits : 1));
+
+    MctsNode* best = nullptr;
+    double bestValue = -1.0;
+    for (int i = 0; i < node->childCount; i++) {
+        MctsNode* c = &node->children[i];
+        uint32_t n = c->visits.load(std::memory_order_relaxed) + c->virtualLoss.load(std::memory_order_relaxed);
+        if (n == 0) return c; // Enfant jamais essaye
+        double q = c->halfPoints.load(std::memory_order_relaxed) / (2.0 * n);
+        double value = q + exploration * std::sqrt(logParent / n);
+        if (value > bestValue) { bestValue = value; best = c; }
+    }
+    return best;
+}
+
+// Cree les enfants d'une feuille (un seul thread y parvient, les autres jouent un playout)
+template <class B>
+bool MctsExpand(MctsNode* node, const B& b, MctsArena& arena) {
+    uint8_t expected = NODE_LEAF;
+    if (!node->state.compare_exchange_strong(expected, NODE_EXPANDING, std::memory_order_acquire)) return false;
+
+    typename B::MoveList moves = LegalMoves(b);
+    MctsNode* block = arena.Allocate(moves.count);
+    if (!block) {
+        node->state.store(NODE_LEAF, std::memory_order_release);
+        return false;
+    }
+    for (int i = 0; i < moves.count; i++) block[i].Init(moves.moves[i], b.sideToMove);
+    node->children = block;
+    node->childCount = (uint8_t)moves.count;
+    node->state.store(NODE_EXPANDED, std::memory_order_release); // Publie enfants + compte
+    return true;
+}
+
+// Une iteration : selection, expansion, playout, remontee
+template <class B>
+void MctsIterate(MctsNode* root, const B& rootBoard, const MctsLimits& limits, MctsArena& arena, Rng& rng) {
+    MctsNode* path[MCTS_MAX_PATH];
+    int length = 0;
+    B b = rootBoard;
+
+    MctsNode* node = root;
+    node->virtualLoss.fetch_add(1, std::memory_order_relaxed);
+    path[length++] = node;
+
+    while (length < MCTS_MAX_PATH) {
+        if (node->state.load(std::memory_order_acquire) != NODE_EXPANDED) {
+            // Feuille deja visitee : on la developpe et on descend d'un cran
+            if (IsTerminal(b) || node->visits.load(std::memory_order_relaxed) == 0 || !MctsExpand(node, b, arena)) break;
+        }
+        if (node->childCount == 0) break;
+        node = MctsSelect(node, limits.exploration);
+        ApplyMove(b, node->move);
+        node->virtualLoss.fetch_add(1, std::memory_order_relaxed);
+        path[length++] = node;
+    }
+
+    int winner = IsTerminal(b) ? Winner(b) : MctsPlayout(b, rng, limits.maxPlayoutPlies);
+
+    for (int i = 0; i < length; i++) {
+        MctsNode* n = path[i];
+        uint32_t reward = winner < 0 ? 1 : (winner == n->mover ? 2 : 0);
+        n->halfPoints.fetch_add(reward, std::memory_order_relaxed);
+        n->visits.fetch_add(1, std::memory_order_relaxed);
+        n->virtualLoss.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+template <class B>
+MctsResult MctsSearch(const B& b, const MctsLimits& limits, MctsArena& arena) {
+    typedef std::chrono::steady_clock Clock;
+    MctsResult result;
+    Clock::time_point start = Clock::now();
+
+    typename B::MoveList moves = LegalMoves(b);
+    if (moves.count == 0) return result;
+    result.bestMove = moves.moves[0];
+    if (moves.count == 1) { // Coup force
+        result.pv[0] = result.bestMove;
+        result.pvLength = 1;
+        return result;
+    }
+
+    arena.Reset();
+    MctsNode* root = arena.Allocate(1);
+    if (!root) return result; // Arene de capacite nulle
+    root->Init(-1, 1 - b.sideToMove);
+    MctsExpand(root, b, arena);
+
+    int threadCount = limits.threads > 0 ? limits.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    long maxIterations = (limits.iterations > 0 || limits.timeLimitMs > 0) ? limits.iterations : 10000;
+    Clock::time_point deadline = start + std::chrono::milliseconds(limits.timeLimitMs);
+    std::atomic<long> iterations(0);
+    std::atomic<bool> stop(false);
+
+    auto worker = [&](int t) {
+        Rng rng(limits.seed, (uint64_t)t);
+        for (long done = 0; !stop.load(std::memory_order_relaxed); done++) {
+            long n = iterations.fetch_add(1, std::memory_order_relaxed);
+            if (maxIterations > 0 && n >= maxIterations) break;
+            MctsIterate(root, b, limits, arena, rng);
+            if (limits.timeLimitMs > 0 && (done & 63) == 63 && Clock::now() >= deadline) stop.store(true, std::memory_order_relaxed);
+            if (limits.stop && limits.stop->load(std::memory_order_relaxed)) stop.store(true, std::memory_order_relaxed);
+        }
+    };
+    std::vector<std::thread> helpers;
+    for (int t = 1; t < threadCount; t++) helpers.emplace_back(worker, t);
+    worker(0);
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& h : helpers) h.join();
+
+    // Meilleur coup = le plus visite (plus robuste que le meilleur taux)
+    const MctsNode* node = root;
+    while (node->state.load(std::memory_order_acquire) == NODE_EXPANDED && node->childCount > 0 && result.pvLength < 64) {
+        const MctsNode* best = &node->children[0];
+        for (int i = 1; i < node->childCount; i++) {
+            if (node->children[i].visits.load(std::memory_order_relaxed) > best->visits.load(std::memory_order_relaxed)) best = &node->children[i];
+        }
+        if (best->visits.load(std::memory_order_relaxed) == 0) break;
+        if (node == root) {
+            result.bestMove = best->move;
+            result.winRate = best->halfPoints.load(std::memory_order_relaxed) / (2.0 * best->visits.load(std::memory_order_relaxed));
+        }
+        result.pv[result.pvLength++] = best->move;
+        node = best;
+    }
+
+    long total = iterations.load(std::memory_order_relaxed);
+    result.iterations = (maxIterations > 0 && total > maxIterations) ? maxIterations : total;
+    result.nodes = arena.Used();
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+#endif
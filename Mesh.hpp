@@ -11,6 +11,18 @@ struct Vertex {
     glm::vec2 TexCoords;
 };
 
+// Attributs par instance (graines : un seul appel pour toutes)
+struct InstanceData {
+    glm::vec3 Offset; // Translation de l'instance (Layout 3)
+    glm::vec3 Color;  // Couleur de l'instance (Layout 4)
+};
+
+// Attributs par sommet d'un maillage fusionne (scene fixe, voir Geometry::Bake)
+struct VertexTint {
+    glm::vec3 Color;  // Teinte (Layout 4, comme la couleur d'une instance)
+    float Texture;    // 0 : texture1, 1 : texture2 (Layout 5)
+};
+
 class Mesh {
 public:
     std::vector<Vertex> vertices;
@@ -29,14 +41,54 @@ public:
         glBindVertexArray(0);
     }
 
+    // Teinte et texture de chaque sommet (un element par sommet) ; reecrites a chaque appel
+    void SetVertexTints(const std::vector<VertexTint>& tints) {
+        glBindVertexArray(VAO);
+        if (tintVBO == 0) {
+            glGenBuffers(1, &tintVBO);
+            glBindBuffer(GL_ARRAY_BUFFER, tintVBO);
+            glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(VertexTint), NULL, GL_STATIC_DRAW);
+            glEnableVertexAttribArray(4);
+            glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(VertexTint), (void*)offsetof(VertexTint, Color));
+            glEnableVertexAttribArray(5);
+            glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(VertexTint), (void*)offsetof(VertexTint, Texture));
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, tintVBO);
+        size_t count = tints.size() < vertices.size() ? tints.size() : vertices.size();
+        if (count > 0) glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(VertexTint), tints.data());
+        glBindVertexArray(0);
+    }
+
+    // Toutes les instances d'un coup (voir SetInstanceBuffer)
+    void DrawInstanced(int count) {
+        glBindVertexArray(VAO);
+        glDrawElementsInstanced(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0, count);
+        glBindVertexArray(0);
+    }
+
+    // Branche un tampon d'InstanceData sur les layouts 3 et 4 (un element par instance)
+    void SetInstanceBuffer(unsigned int buffer) {
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, Offset));
+        glVertexAttribDivisor(3, 1);
+        glEnableVertexAttribArray(4);
+        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, Color));
+        glVertexAttribDivisor(4, 1);
+        glBindVertexArray(0);
+    }
+
     void Delete() {
         glDeleteVertexArrays(1, &VAO);
         glDeleteBuffers(1, &VBO);
         glDeleteBuffers(1, &EBO);
+        if (tintVBO != 0) glDeleteBuffers(1, &tintVBO);
     }
 
 private:
     unsigned int VBO, EBO;
+    unsigned int tintVBO = 0; // Voir SetVertexTints
 
     void setupMesh() {
         glGenVertexArrays(1, &VAO);
@@ -66,4 +118,57 @@ private:
         glBindVertexArray(0);
     }
 };
+
+// Maillage reecrit en place (etiquettes...) : tampons alloues une fois a leur
+// taille maximale, puis mis a jour par glBufferSubData, sans recreer de VAO
+class DynamicMesh {
+public:
+    unsigned int VAO;
+
+    DynamicMesh(size_t maxVertices, size_t maxIndices) : maxVertices(maxVertices), maxIndices(maxIndices) {
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glGenBuffers(1, &EBO);
+
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, maxVertices * sizeof(Vertex), NULL, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, maxIndices * sizeof(unsigned int), NULL, GL_DYNAMIC_DRAW);
+
+        // Meme disposition que Mesh (layouts 0, 1, 2)
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+        glBindVertexArray(0);
+    }
+
+    // Remplace le contenu (tronque a la capacite)
+    void Update(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+        size_t v = vertices.size() < maxVertices ? vertices.size() : maxVertices;
+        indexCount = indices.size() < maxIndices ? indices.size() : maxIndices;
+        glBindVertexArray(VAO); // Le tampon d'indices lie fait partie de l'etat du VAO
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        if (v > 0) glBufferSubData(GL_ARRAY_BUFFER, 0, v * sizeof(Vertex), vertices.data());
+        if (indexCount > 0) glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * sizeof(unsigned int), indices.data());
+        glBindVertexArray(0);
+    }
+
+    // Triangles des indices [first, first + count)
+    void DrawRange(size_t first, size_t count) {
+        if (first >= indexCount) return;
+        if (first + count > indexCount) count = indexCount - first;
+        glBindVertexArray(VAO);
+        glDrawElements(GL_TRIANGLES, (GLsizei)count, GL_UNSIGNED_INT, (void*)(first * sizeof(unsigned int)));
+        glBindVertexArray(0);
+    }
+
+private:
+    unsigned int VBO, EBO;
+    size_t maxVertices, maxIndices;
+    size_t indexCount = 0;
+};
 #endif
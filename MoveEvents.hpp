@@ -0,0 +1,105 @@
+#ifndef MOVEEVENTS_HPP
+#define MOVEEVENTS_HPP
+
+#include <cstring>
+
+#include "Board.hpp"
+
+// Flux d'evenements d'un coup : ce que la vue anime, ce que le message
+// de statut affiche et ce qu'un enregistreur archive. Capacite fixe,
+// reutilise d'un coup a l'autre : aucune allocation pendant l'animation.
+
+enum MoveEventType : uint8_t {
+    EV_PICKUP,        // pit = trou vide, amount = graines en main
+    EV_SEED_DROPPED,  // pit = trou qui recoit une graine
+    EV_CAPTURE,       // pit = trou vide par la capture, target = magasin, amount = graines prises
+    EV_EXTRA_TURN,    // pit = joueur qui rejoue
+    EV_TURN_PASSED,   // pit = joueur au trait
+    EV_SWEEP,         // pit = joueur, amount = graines ramassees dans son magasin
+    EV_GAME_OVER      // pit = vainqueur (0, 1) ou 2 pour egalite
+};
+
+struct MoveEvent {
+    uint8_t type;
+    uint8_t pit;
+    uint8_t target;
+    uint8_t amount;
+};
+
+template <class BoardT>
+class MoveEventStream {
+public:
+    // Pire cas : toutes les graines du plateau en main + une capture par trou + la fin de coup
+    static constexpr int CAPACITY = BoardT::TOTAL_SEEDS + BoardT::NUM_PITS + 8;
+
+    MoveEvent events[CAPACITY];
+    int count = 0;
+
+    void Clear() { count = 0; }
+
+    void Push(uint8_t type, int pit, int target = 0, int amount = 0) {
+        if (count >= CAPACITY) return;
+        MoveEvent& e = events[count++];
+        e.type = type; e.pit = (uint8_t)pit; e.target = (uint8_t)target; e.amount = (uint8_t)amount;
+    }
+};
+
+// Lecture sequentielle du flux (chaque lecteur a son propre curseur)
+struct MoveEventCursor {
+    const MoveEvent* events = nullptr;
+    int count = 0;
+    int pos = 0;
+
+    bool Done() const { return pos >= count; }
+    const MoveEvent& Peek() const { return events[pos]; }
+    const MoveEvent& Next() { return events[pos++]; }
+};
+
+template <class BoardT>
+inline MoveEventCursor ReadEvents(const MoveEventStream<BoardT>& stream) {
+    MoveEventCursor c;
+    c.events = stream.events;
+    c.count = stream.count;
+    return c;
+}
+
+// Deux deroulements identiques (meme suite d'evenements)
+template <class BoardT>
+inline bool SameEvents(const MoveEventStream<BoardT>& a, const MoveEventStream<BoardT>& b) {
+    return a.count == b.count && std::memcmp(a.events, b.events, a.count * sizeof(MoveEvent)) == 0;
+}
+
+// Joue le coup avec ApplyMove et decrit son deroulement dans 'out'
+template <class BoardT>
+inline MoveResult RecordMove(BoardT& b, int pit, MoveEventStream<BoardT>& out) {
+    int player = b.sideToMove;
+    int seedsInHand = b.seeds[pit];
+
+    // Graines de chaque trou juste apres la distribution (montants captures)
+    BoardT sown = b;
+    SowSeeds(sown, pit);
+
+    MoveResult r = ApplyMove(b, pit);
+
+    out.Clear();
+    out.Push(EV_PICKUP, pit, 0, seedsInHand);
+    for (int k = 1; k <= seedsInHand; k++) out.Push(EV_SEED_DROPPED, BoardT::SowTarget(pit, player, k));
+
+    for (int i = 0; i < BoardT::NUM_PITS; i++) {
+        if (r.capturedPits & (1u << i)) out.Push(EV_CAPTURE, i, BoardT::StoreOf(player), sown.seeds[i]);
+    }
+
+    if (r.gameOver) {
+        out.Push(EV_SWEEP, 0, 0, r.swept[0]);
+        out.Push(EV_SWEEP, 1, 0, r.swept[1]);
+        int w = Winner(b);
+        out.Push(EV_GAME_OVER, w < 0 ? 2 : w);
+    } else if (r.extraTurn) {
+        out.Push(EV_EXTRA_TURN, player);
+    } else {
+        out.Push(EV_TURN_PASSED, b.sideToMove);
+    }
+    return r;
+}
+
+#endif
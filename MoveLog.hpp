@@ -0,0 +1,153 @@
+#ifndef MOVELOG_HPP
+#define MOVELOG_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "Board.hpp"
+
+// Jouer / defaire un coup sur place (make / unmake) et historique de partie.
+// Un coup ne garde que ce qu'il detruit : trou joue et son contenu, trait
+// d'avant, capture, ramassage final. Le reste (distribution) se recalcule :
+// UnmakeMove retire les tours complets et le reste comme SowSeeds les pose.
+
+enum MoveUndoFlags : uint8_t {
+    UNDO_EXTRA_TURN = 1, // Le joueur a rejoue
+    UNDO_SWEPT      = 2  // Partie finie : ramassage final effectue (sweptPits valide)
+};
+
+template <class B>
+struct MoveUndo {
+    uint8_t pit;             // Trou joue
+    uint8_t seeds;           // Graines qu'il contenait
+    uint8_t lastPit;         // Trou de la derniere graine
+    uint8_t side;            // Joueur au trait avant le coup
+    uint8_t captured;        // Graines capturees (0 si pas de capture)
+    uint8_t flags;           // MoveUndoFlags
+    uint32_t capturedPits;   // Trous vides par la capture
+    uint32_t capturedThrees; // Oware : trous captures qui avaient 3 graines (les autres en avaient 2)
+    uint8_t sweptPits[2 * B::PITS_PER_SIDE]; // Trous avant le ramassage final (si UNDO_SWEPT)
+};
+
+// Joue un coup legal sur 'b' en notant dans 'u' de quoi le defaire
+template <class B>
+inline MoveResult MakeMove(B& b, int pit, MoveUndo<B>& u) {
+    int player = b.sideToMove;
+    u.pit = (uint8_t)pit;
+    u.seeds = b.seeds[pit];
+    u.side = (uint8_t)player;
+
+    int last = SowSeeds(b, pit);
+    // Oware : une capture prend 2 ou 3 graines par trou, on note lesquels en avaient 3
+    uint32_t threes = 0;
+    if (B::Rules::CAPTURE == CAPTURE_TWO_OR_THREE) {
+        int first = B::FirstPitOf(1 - player);
+        for (int i = first; i < first + B::PITS_PER_SIDE; i++) {
+            if (b.seeds[i] == 3) threes |= 1u << i;
+        }
+    }
+
+    MoveResult r = ResolveMove(b, last, u.sweptPits);
+    u.lastPit = (uint8_t)last;
+    u.captured = (uint8_t)r.captured;
+    u.capturedPits = r.capturedPits;
+    u.capturedThrees = threes & r.capturedPits;
+    u.flags = (uint8_t)((r.extraTurn ? UNDO_EXTRA_TURN : 0) | (r.gameOver ? UNDO_SWEPT : 0));
+    return r;
+}
+
+// Remet 'b' exactement dans l'etat d'avant MakeMove(b, u.pit, u), en O(trous)
+template <class B>
+inline void UnmakeMove(B& b, const MoveUndo<B>& u) {
+    int player = u.side;
+
+    // Ramassage final : les trous reprennent leur contenu, les magasins le rendent
+    if (u.flags & UNDO_SWEPT) {
+        for (int side = 0; side < 2; side++) {
+            int first = B::FirstPitOf(side);
+            int total = 0;
+            for (int i = 0; i < B::PITS_PER_SIDE; i++) {
+                b.seeds[first + i] = u.sweptPits[side * B::PITS_PER_SIDE + i];
+                total += b.seeds[first + i];
+            }
+            b.seeds[B::StoreOf(side)] -= total;
+        }
+    }
+
+    // Capture
+    if (u.captured > 0) {
+        b.seeds[B::StoreOf(player)] -= u.captured;
+        if (B::Rules::CAPTURE == CAPTURE_EMPTY_OWN_PIT) {
+            b.seeds[u.lastPit] = 1;
+            b.seeds[B::OppositePit(u.lastPit)] = u.captured - 1;
+        } else {
+            for (int i = 0; i < B::NUM_PITS; i++) {
+                if (u.capturedPits & (1u << i)) b.seeds[i] = (u.capturedThrees & (1u << i)) ? 3 : 2;
+            }
+        }
+    }
+
+    // Distribution a l'envers : le reste puis les tours complets
+    int laps = u.seeds / B::SOW_LAP;
+    int remainder = u.seeds % B::SOW_LAP;
+    int idx = u.pit;
+    for (int i = 0; i < remainder; i++) {
+        idx = B::NextSowPit(idx, player);
+        b.seeds[idx]--;
+    }
+    if (laps > 0) {
+        for (int k = 0; k < B::SOW_RING; k++) b.seeds[B::TABLES.ringPit[player][k]] -= laps;
+    }
+    b.seeds[u.pit] = u.seeds; // Ecrase aussi le trou de depart saute (Oware)
+    b.sideToMove = (uint8_t)player;
+}
+
+// --- HISTORIQUE DE PARTIE ---
+// Les coups joues depuis la position de depart et un curseur : Undo defait le
+// coup sous le curseur, Redo le rejoue. Jouer un nouveau coup apres des Undo
+// oublie la suite annulee.
+template <class B>
+class MoveLog {
+public:
+    void Clear() {
+        records.clear();
+        ply = 0;
+    }
+
+    // Joue un coup legal sur 'b' (position au curseur) et l'ajoute au journal
+    MoveResult Play(B& b, int pit) {
+        records.resize(ply + 1);
+        return MakeMove(b, pit, records[ply++]);
+    }
+
+    bool Undo(B& b) {
+        if (ply == 0) return false;
+        UnmakeMove(b, records[--ply]);
+        return true;
+    }
+
+    bool Redo(B& b) {
+        if (ply == Length()) return false;
+        MakeMove(b, records[ply].pit, records[ply]);
+        ply++;
+        return true;
+    }
+
+    // Amene 'b' au demi-coup 'target' (0 = depart, Length() = dernier coup joue)
+    bool JumpTo(B& b, int target) {
+        if (target < 0 || target > Length()) return false;
+        while (ply > target) Undo(b);
+        while (ply < target) Redo(b);
+        return true;
+    }
+
+    int Ply() const { return ply; }
+    int Length() const { return (int)records.size(); }
+    const MoveUndo<B>& operator[](int i) const { return records[i]; }
+
+private:
+    std::vector<MoveUndo<B>> records;
+    int ply = 0; // Coups joues sur la position courante
+};
+
+#endif
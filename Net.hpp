@@ -0,0 +1,318 @@
+#ifndef NET_HPP
+#define NET_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "Protocol.hpp"
+
+// Sockets TCP (et Unix hors Windows) : ouverture, ecoute, mode non bloquant,
+// et le client du protocole (Protocol.hpp) que le jeu 3D interroge a chaque image.
+
+#ifdef _WIN32
+typedef SOCKET SocketHandle;
+const SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+#else
+typedef int SocketHandle;
+const SocketHandle INVALID_SOCKET_HANDLE = -1;
+#endif
+
+// A appeler une fois avant tout socket (WSAStartup sous Windows)
+inline bool NetStartup() {
+#ifdef _WIN32
+    static bool started = false;
+    if (!started) {
+        WSADATA data;
+        started = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }
+    return started;
+#else
+    return true;
+#endif
+}
+
+inline void CloseSocket(SocketHandle s) {
+    if (s == INVALID_SOCKET_HANDLE) return;
+#ifdef _WIN32
+    closesocket(s);
+#else
+    close(s);
+#endif
+}
+
+inline bool SetNonBlocking(SocketHandle s) {
+#ifdef _WIN32
+    u_long on = 1;
+    return ioctlsocket(s, FIONBIO, &on) == 0;
+#else
+    int flags = fcntl(s, F_GETFL, 0);
+    return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+// La derniere operation a echoue faute de donnees ou de place : a reessayer plus tard
+inline bool NetWouldBlock() {
+#ifdef _WIN32
+    int e = WSAGetLastError();
+    return e == WSAEWOULDBLOCK || e == WSAEINPROGRESS;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+
+// Envoi sans signal SIGPIPE si l'autre bout est deja parti
+inline long NetSend(SocketHandle s, const uint8_t* data, size_t size) {
+#if defined(_WIN32)
+    return send(s, (const char*)data, (int)size, 0);
+#elif defined(MSG_NOSIGNAL)
+    return (long)send(s, data, size, MSG_NOSIGNAL);
+#else
+    return (long)send(s, data, size, 0);
+#endif
+}
+
+inline long NetReceive(SocketHandle s, uint8_t* data, size_t size) {
+#ifdef _WIN32
+    return recv(s, (char*)data, (int)size, 0);
+#else
+    return (long)recv(s, data, size, 0);
+#endif
+}
+
+// Sous Linux, un serveur ou un generateur de charge depasse vite les 1024
+// descripteurs par defaut : on monte la limite souple jusqu'a la limite dure
+inline void RaiseFileLimit() {
+#ifndef _WIN32
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+#endif
+}
+
+// --- ADRESSES ---
+// "hote:port", ":port" (toutes les interfaces en ecoute, 127.0.0.1 en connexion)
+// ou "unix:/chemin/du/socket" (Linux et macOS)
+struct NetAddress {
+    bool unixSocket = false;
+    std::string host;
+    int port = 0;
+    std::string path;
+};
+
+inline bool ParseNetAddress(const std::string& text, NetAddress& out) {
+    out = NetAddress();
+    if (text.compare(0, 5, "unix:") == 0) {
+        out.unixSocket = true;
+        out.path = text.substr(5);
+        return !out.path.empty();
+    }
+    size_t colon = text.rfind(':');
+    std::string port = colon == std::string::npos ? text : text.substr(colon + 1);
+    if (colon != std::string::npos) out.host = text.substr(0, colon);
+    out.port = std::atoi(port.c_str());
+    return out.port > 0 && out.port < 65536;
+}
+
+inline std::string FormatNetAddress(const NetAddress& a) {
+    if (a.unixSocket) return "unix:" + a.path;
+    return (a.host.empty() ? std::string("*") : a.host) + ":" + std::to_string(a.port);
+}
+
+// Adresse IPv4 d'un hote ("" = 'fallback')
+inline bool ResolveIpv4(const std::string& host, const char* fallback, sockaddr_in& out) {
+    std::memset(&out, 0, sizeof(out));
+    out.sin_family = AF_INET;
+    std::string name = host.empty() ? fallback : host;
+    if (inet_pton(AF_INET, name.c_str(), &out.sin_addr) == 1) return true;
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found = nullptr;
+    if (getaddrinfo(name.c_str(), nullptr, &hints, &found) != 0 || !found) return false;
+    out.sin_addr = ((sockaddr_in*)found->ai_addr)->sin_addr;
+    freeaddrinfo(found);
+    return true;
+}
+
+// Connexion bloquante (le serveur est local ou proche), puis TCP_NODELAY :
+// un coup tient en quelques octets et ne doit pas attendre le suivant
+inline SocketHandle NetConnect(const NetAddress& a) {
+    if (!NetStartup()) return INVALID_SOCKET_HANDLE;
+    SocketHandle s = INVALID_SOCKET_HANDLE;
+    if (a.unixSocket) {
+#ifdef _WIN32
+        std::cerr << "Sockets Unix non geres sous Windows" << std::endl;
+#else
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (a.path.size() >= sizeof(addr.sun_path)) return INVALID_SOCKET_HANDLE;
+        std::strcpy(addr.sun_path, a.path.c_str());
+        s = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (s != INVALID_SOCKET_HANDLE && connect(s, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            CloseSocket(s);
+            s = INVALID_SOCKET_HANDLE;
+        }
+#endif
+        return s;
+    }
+    sockaddr_in addr;
+    if (!ResolveIpv4(a.host, "127.0.0.1", addr)) return INVALID_SOCKET_HANDLE;
+    addr.sin_port = htons((uint16_t)a.port);
+    s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s == INVALID_SOCKET_HANDLE) return s;
+    if (connect(s, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        CloseSocket(s);
+        return INVALID_SOCKET_HANDLE;
+    }
+    int on = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char*)&on, sizeof(on));
+    return s;
+}
+
+// Socket d'ecoute non bloquant (un socket Unix existant est remplace)
+inline SocketHandle NetListen(const NetAddress& a, int backlog = 4096) {
+    if (!NetStartup()) return INVALID_SOCKET_HANDLE;
+    SocketHandle s = INVALID_SOCKET_HANDLE;
+    if (a.unixSocket) {
+#ifndef _WIN32
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (a.path.size() >= sizeof(addr.sun_path)) return INVALID_SOCKET_HANDLE;
+        std::strcpy(addr.sun_path, a.path.c_str());
+        unlink(a.path.c_str());
+        s = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (s != INVALID_SOCKET_HANDLE && bind(s, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            CloseSocket(s);
+            s = INVALID_SOCKET_HANDLE;
+        }
+#endif
+    } else {
+        sockaddr_in addr;
+        if (!ResolveIpv4(a.host, "0.0.0.0", addr)) return INVALID_SOCKET_HANDLE;
+        addr.sin_port = htons((uint16_t)a.port);
+        s = socket(AF_INET, SOCK_STREAM, 0);
+        int on = 1;
+        if (s != INVALID_SOCKET_HANDLE) setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&on, sizeof(on));
+        if (s != INVALID_SOCKET_HANDLE && bind(s, (sockaddr*)&addr, sizeof(addr)) != 0) {
+            CloseSocket(s);
+            s = INVALID_SOCKET_HANDLE;
+        }
+    }
+    if (s == INVALID_SOCKET_HANDLE) return s;
+    if (listen(s, backlog) != 0 || !SetNonBlocking(s)) {
+        CloseSocket(s);
+        return INVALID_SOCKET_HANDLE;
+    }
+    return s;
+}
+
+// --- CLIENT ---
+// Connexion non bloquante au serveur de parties : Send met en file et envoie
+// ce qui passe, Poll recoit sans jamais attendre. Le jeu 3D appelle Poll a
+// chaque image puis lit les messages avec NextMessage.
+class NetClient {
+public:
+    ~NetClient() { Close(); }
+
+    bool Connect(const std::string& address) {
+        Close();
+        NetAddress a;
+        if (!ParseNetAddress(address, a)) {
+            std::cerr << "Adresse de serveur invalide : " << address << std::endl;
+            return false;
+        }
+        socket = NetConnect(a);
+        if (socket == INVALID_SOCKET_HANDLE || !SetNonBlocking(socket)) {
+            std::cerr << "Connexion impossible au serveur " << address << std::endl;
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void Close() {
+        CloseSocket(socket);
+        socket = INVALID_SOCKET_HANDLE;
+        in = FrameBuffer();
+        out.clear();
+        outPos = 0;
+    }
+
+    bool IsConnected() const { return socket != INVALID_SOCKET_HANDLE; }
+
+    bool Send(uint8_t type, const void* payload = nullptr, int size = 0) {
+        if (!IsConnected()) return false;
+        AppendFrame(out, type, payload, size);
+        return Flush();
+    }
+
+    // Envoie ce qui attend et recoit ce qui est arrive ; false si la connexion est perdue
+    bool Poll() {
+        if (!IsConnected() || !Flush()) return false;
+        uint8_t buffer[4096];
+        for (;;) {
+            long n = NetReceive(socket, buffer, sizeof(buffer));
+            if (n > 0) { in.Append(buffer, (size_t)n); continue; }
+            if (n < 0 && NetWouldBlock()) return true;
+            Close(); // n == 0 : le serveur a ferme
+            return false;
+        }
+    }
+
+    // Message suivant deja recu (valide jusqu'au prochain Poll)
+    bool NextMessage(NetMessage& m) {
+        bool bad = false;
+        if (in.Next(m, bad)) return true;
+        if (bad) Close();
+        return false;
+    }
+
+private:
+    bool Flush() {
+        while (outPos < out.size()) {
+            long n = NetSend(socket, out.data() + outPos, out.size() - outPos);
+            if (n > 0) { outPos += (size_t)n; continue; }
+            if (n < 0 && NetWouldBlock()) return true;
+            Close();
+            return false;
+        }
+        out.clear();
+        outPos = 0;
+        return true;
+    }
+
+    SocketHandle socket = INVALID_SOCKET_HANDLE;
+    FrameBuffer in;
+    std::vector<uint8_t> out;
+    size_t outPos = 0;
+};
+
+#endif
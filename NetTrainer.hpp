@@ -0,0 +1,257 @@
+#ifndef NETTRAINER_HPP
+#define NETTRAINER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "Board.hpp"
+#include "GameRecord.hpp"
+#include "NeuralEval.hpp"
+#include "Rng.hpp"
+#include "Search.hpp"
+
+// Entrainement hors ligne du reseau d'evaluation (NeuralEval.hpp) sur une
+// archive de parties (selfplay --record). Chaque position non decidee d'une
+// partie achevee devient un exemple : ses entrees, et pour cible l'ecart final
+// de la partie moins la difference de magasins du moment, du point de vue du
+// joueur au trait (ce que le reseau doit ajouter a la difference de magasins).
+//
+// Le modele est entraine en reels (Adam, mini-lots, ReLU bornee a [0, 1] comme
+// la version entiere), les poids des couches 2 et 3 etant tenus dans ce que
+// l'int8 peut representer ; il est ensuite quantifie tel quel. Les parties de
+// validation (une sur vingt) ne servent qu'aux mesures.
+
+struct TrainerConfig {
+    int epochs = 20;
+    int batch = 256;
+    double learningRate = 0.001;
+    uint64_t seed = 1;
+};
+
+struct TrainerReport {
+    long games = 0;
+    long samples = 0;           // Exemples d'entrainement
+    long validation = 0;        // Exemples de validation
+    double baselineMse = 0.0;   // Difference de magasins seule (correction nulle), en graines^2
+    double floatMse = 0.0;      // Modele reel
+    double quantizedMse = 0.0;  // Reseau entier ecrit dans le fichier
+};
+
+// Un exemple : entrees actives des deux points de vue (joueur au trait d'abord)
+template <class B>
+struct TrainSample {
+    uint16_t features[2][B::NUM_PITS];
+    float target;
+    B position;                 // Pour la mesure du reseau quantifie
+};
+
+template <class B>
+class NetTrainer {
+public:
+    // Exemples tires de toutes les parties achevees de l'archive
+    bool Load(GameRecordReader& reader, TrainerReport& report) {
+        GameRecordView g;
+        reader.Rewind();
+        while (reader.Next(g)) {
+            if (g.header.flags & RECORD_TRUNCATED) continue; // Ecart final arbitraire
+            B final;
+            if (!ReplayGameRecord(g, final)) continue;
+            std::vector<TrainSample<B>>& out = g.index % 20 == 19 ? validation : samples;
+            B b = B::Initial();
+            for (int i = 0; i < g.header.moveCount; i++) {
+                if (!IsDecided(b)) out.push_back(MakeSample(b, final));
+                ApplyMove(b, g.moves[i]);
+            }
+            report.games++;
+        }
+        report.samples = (long)samples.size();
+        report.validation = (long)validation.size();
+        return !samples.empty() && !validation.empty();
+    }
+
+    void Train(const TrainerConfig& cfg, TrainerReport& report) {
+        Rng rng(cfg.seed);
+        Init(rng);
+        std::vector<uint32_t> order(samples.size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = (uint32_t)i;
+
+        for (int epoch = 0; epoch < cfg.epochs; epoch++) {
+            for (size_t i = order.size(); i > 1; i--) std::swap(order[i - 1], order[rng.Below((int)i)]);
+            double loss = 0.0;
+            for (size_t start = 0; start < order.size(); start += cfg.batch) {
+                size_t end = std::min(order.size(), start + (size_t)cfg.batch);
+                grad.assign(params.size(), 0.0f);
+                for (size_t k = start; k < end; k++) loss += Backward(samples[order[k]], 1.0f / (float)(end - start));
+                AdamStep(cfg.learningRate);
+            }
+            std::cout << "Epoque " << epoch + 1 << " : entrainement " << loss / samples.size()
+                      << ", validation " << FloatMse(validation) << std::endl;
+        }
+
+        report.baselineMse = 0.0;
+        for (const TrainSample<B>& s : validation) report.baselineMse += s.target * s.target;
+        report.baselineMse /= validation.size();
+        report.floatMse = FloatMse(validation);
+    }
+
+    // Poids entiers du modele (arrondis, bornes a leur type)
+    void Quantize(NetWeights& w) const {
+        std::memset(&w, 0, sizeof(w));
+        for (int f = 0; f < NN_INPUTS; f++)
+            for (int j = 0; j < NN_HIDDEN1; j++) w.w1[f][j] = (int16_t)Round(params[W1 + f * NN_HIDDEN1 + j] * NN_ACT_ONE, 32767);
+        for (int j = 0; j < NN_HIDDEN1; j++) w.b1[j] = (int16_t)Round(params[B1 + j] * NN_ACT_ONE, 32767);
+        for (int k = 0; k < NN_HIDDEN2; k++) {
+            for (int i = 0; i < 2 * NN_HIDDEN1; i++) w.w2[k][i] = (int8_t)Round(params[W2 + k * 2 * NN_HIDDEN1 + i] * NN_WEIGHT_ONE, 127);
+            w.b2[k] = (int32_t)Round(params[B2 + k] * NN_OUTPUT_ONE, 1 << 30);
+            w.w3[k] = (int8_t)Round(params[W3 + k] * NN_WEIGHT_ONE, 127);
+        }
+        w.b3 = (int32_t)Round(params[B3] * NN_OUTPUT_ONE, 1 << 30);
+    }
+
+    // Erreur du reseau entier sur la validation (memes arrondis que la recherche)
+    double QuantizedMse(const NeuralNet& net) const {
+        double sum = 0.0;
+        NnAccumulator acc;
+        for (const TrainSample<B>& s : validation) {
+            net.Refresh(s.position, acc);
+            int me = s.position.sideToMove;
+            int diff = s.position.seeds[B::StoreOf(me)] - s.position.seeds[B::StoreOf(1 - me)];
+            double e = (net.Evaluate(s.position, acc) - diff) - s.target;
+            sum += e * e;
+        }
+        return sum / validation.size();
+    }
+
+private:
+    // Parametres reels, a plat : memes dimensions que NetWeights
+    static const int W1 = 0;
+    static const int B1 = W1 + NN_INPUTS * NN_HIDDEN1;
+    static const int W2 = B1 + NN_HIDDEN1;
+    static const int B2 = W2 + NN_HIDDEN2 * 2 * NN_HIDDEN1;
+    static const int W3 = B2 + NN_HIDDEN2;
+    static const int B3 = W3 + NN_HIDDEN2;
+    static const int PARAMS = B3 + 1;
+
+    static TrainSample<B> MakeSample(const B& b, const B& final) {
+        TrainSample<B> s;
+        int me = b.sideToMove;
+        for (int pit = 0; pit < B::NUM_PITS; pit++) {
+            s.features[0][pit] = (uint16_t)NnFeature<B>(me, pit, b.seeds[pit]);
+            s.features[1][pit] = (uint16_t)NnFeature<B>(1 - me, pit, b.seeds[pit]);
+        }
+        int margin = final.seeds[B::StoreOf(me)] - final.seeds[B::StoreOf(1 - me)];
+        int diff = b.seeds[B::StoreOf(me)] - b.seeds[B::StoreOf(1 - me)];
+        int target = std::max(-NN_MAX_CORRECTION, std::min(NN_MAX_CORRECTION, margin - diff)); // Le reseau est borne ainsi
+        s.target = (float)target;
+        s.position = b;
+        return s;
+    }
+
+    static long Round(double v, long limit) {
+        long r = std::lround(v);
+        return r > limit ? limit : r < -limit ? -limit : r;
+    }
+
+    static float Clip(float v) { return v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v; }
+
+    void Init(Rng& rng) {
+        params.assign(PARAMS, 0.0f);
+        auto uniform = [&](int first, int count, double scale) {
+            for (int i = 0; i < count; i++) params[first + i] = (float)((2.0 * rng.Uniform() - 1.0) * scale);
+        };
+        uniform(W1, NN_INPUTS * NN_HIDDEN1, 1.0 / std::sqrt((double)B::NUM_PITS));
+        for (int j = 0; j < NN_HIDDEN1; j++) params[B1 + j] = 0.5f; // Neurones actifs au depart
+        uniform(W2, NN_HIDDEN2 * 2 * NN_HIDDEN1, 1.0 / std::sqrt(2.0 * NN_HIDDEN1));
+        uniform(W3, NN_HIDDEN2, 1.0 / std::sqrt((double)NN_HIDDEN2));
+        m.assign(PARAMS, 0.0f);
+        v.assign(PARAMS, 0.0f);
+        step = 0;
+    }
+
+    // Passe avant ; renvoie la sortie et garde les activations pour Backward
+    float Forward(const TrainSample<B>& s, float pre1[2][NN_HIDDEN1], float x[2 * NN_HIDDEN1], float pre2[NN_HIDDEN2],
+                  float h2[NN_HIDDEN2]) const {
+        for (int p = 0; p < 2; p++) {
+            for (int j = 0; j < NN_HIDDEN1; j++) pre1[p][j] = params[B1 + j];
+            for (int pit = 0; pit < B::NUM_PITS; pit++) {
+                const float* row = &params[W1 + s.features[p][pit] * NN_HIDDEN1];
+                for (int j = 0; j < NN_HIDDEN1; j++) pre1[p][j] += row[j];
+            }
+            for (int j = 0; j < NN_HIDDEN1; j++) x[p * NN_HIDDEN1 + j] = Clip(pre1[p][j]);
+        }
+        float out = params[B3];
+        for (int k = 0; k < NN_HIDDEN2; k++) {
+            const float* row = &params[W2 + k * 2 * NN_HIDDEN1];
+            float sum = params[B2 + k];
+            for (int i = 0; i < 2 * NN_HIDDEN1; i++) sum += row[i] * x[i];
+            pre2[k] = sum;
+            h2[k] = Clip(sum);
+            out += params[W3 + k] * h2[k];
+        }
+        return out;
+    }
+
+    // Accumule le gradient de l'erreur quadratique (ponderee par 'scale') ; renvoie l'erreur
+    float Backward(const TrainSample<B>& s, float scale) {
+        float pre1[2][NN_HIDDEN1], x[2 * NN_HIDDEN1], pre2[NN_HIDDEN2], h2[NN_HIDDEN2];
+        float err = Forward(s, pre1, x, pre2, h2) - s.target;
+        float dOut = 2.0f * err * scale;
+        float dx[2 * NN_HIDDEN1] = {};
+        grad[B3] += dOut;
+        for (int k = 0; k < NN_HIDDEN2; k++) {
+            grad[W3 + k] += dOut * h2[k];
+            if (pre2[k] <= 0.0f || pre2[k] >= 1.0f) continue;
+            float d = dOut * params[W3 + k];
+            grad[B2 + k] += d;
+            const float* row = &params[W2 + k * 2 * NN_HIDDEN1];
+            float* g = &grad[W2 + k * 2 * NN_HIDDEN1];
+            for (int i = 0; i < 2 * NN_HIDDEN1; i++) { g[i] += d * x[i]; dx[i] += d * row[i]; }
+        }
+        for (int p = 0; p < 2; p++) {
+            float d1[NN_HIDDEN1];
+            for (int j = 0; j < NN_HIDDEN1; j++) {
+                float pre = pre1[p][j];
+                d1[j] = pre > 0.0f && pre < 1.0f ? dx[p * NN_HIDDEN1 + j] : 0.0f;
+                grad[B1 + j] += d1[j];
+            }
+            for (int pit = 0; pit < B::NUM_PITS; pit++) {
+                float* g = &grad[W1 + s.features[p][pit] * NN_HIDDEN1];
+                for (int j = 0; j < NN_HIDDEN1; j++) g[j] += d1[j];
+            }
+        }
+        return err * err;
+    }
+
+    void AdamStep(double lr) {
+        const float beta1 = 0.9f, beta2 = 0.999f, eps = 1e-8f;
+        step++;
+        float c1 = 1.0f - std::pow(beta1, (float)step);
+        float c2 = 1.0f - std::pow(beta2, (float)step);
+        float limit = 127.0f / NN_WEIGHT_ONE; // Couches 2 et 3 : ce que l'int8 represente
+        for (int i = 0; i < PARAMS; i++) {
+            m[i] = beta1 * m[i] + (1.0f - beta1) * grad[i];
+            v[i] = beta2 * v[i] + (1.0f - beta2) * grad[i] * grad[i];
+            params[i] -= (float)lr * (m[i] / c1) / (std::sqrt(v[i] / c2) + eps);
+            if ((i >= W2 && i < B2) || (i >= W3 && i < B3)) params[i] = std::max(-limit, std::min(limit, params[i]));
+        }
+    }
+
+    double FloatMse(const std::vector<TrainSample<B>>& set) const {
+        float pre1[2][NN_HIDDEN1], x[2 * NN_HIDDEN1], pre2[NN_HIDDEN2], h2[NN_HIDDEN2];
+        double sum = 0.0;
+        for (const TrainSample<B>& s : set) {
+            double e = Forward(s, pre1, x, pre2, h2) - s.target;
+            sum += e * e;
+        }
+        return set.empty() ? 0.0 : sum / set.size();
+    }
+
+    std::vector<TrainSample<B>> samples, validation;
+    std::vector<float> params, grad, m, v;
+    long step = 0;
+};
+
+#endif
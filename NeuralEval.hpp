@@ -0,0 +1,361 @@
+#ifndef NEURALEVAL_HPP
+#define NEURALEVAL_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "Board.hpp"
+#include "BoardSimd.hpp"
+#include "MappedFile.hpp"
+
+// Evaluation par un petit reseau de neurones quantifie (poids int8 / int16).
+//
+// Entrees : chaque trou (magasins compris) vu depuis un camp, son nombre de
+// graines en "un parmi 16" (15 = 15 et plus). Les trous sont renumerotes
+// depuis le camp : ses trous, son magasin, les trous adverses, le magasin
+// adverse. Deux points de vue, un par joueur, partagent les memes poids.
+//
+//   couche 1 : 256 entrees -> 32, int16, par point de vue (l'accumulateur)
+//   couche 2 : les deux points de vue (joueur au trait d'abord), 64 -> 32, int8
+//   sortie   : 32 -> 1, int8 ; correction en graines de la difference de magasins
+//
+// Un coup ne change qu'une poignee de trous : l'accumulateur d'un enfant se
+// deduit de celui du parent en retirant puis ajoutant une ligne de poids par
+// trou modifie et par point de vue (Update), sans reprendre les 14 trous.
+// Les couches 2 et 3 sont vectorisees (SSSE3 / AVX2, choix a l'execution comme
+// BoardSimd.hpp) ; la version scalaire donne exactement les memes entiers.
+
+const int NN_MAX_PITS = 16;                      // Trous et magasins (14 pour 6 trous par camp)
+const int NN_BUCKETS = 16;                       // Graines par trou : 0..14, puis 15 et plus
+const int NN_INPUTS = NN_MAX_PITS * NN_BUCKETS;
+const int NN_HIDDEN1 = 32;                       // Par point de vue
+const int NN_HIDDEN2 = 32;
+const int NN_ACT_ONE = 127;                      // 1.0 en sortie d'activation (ReLU bornee a [0, 1])
+const int NN_WEIGHT_SHIFT = 6;                   // Poids int8 des couches 2 et 3 : 1.0 = 64
+const int NN_WEIGHT_ONE = 1 << NN_WEIGHT_SHIFT;
+const int NN_OUTPUT_ONE = NN_ACT_ONE * NN_WEIGHT_ONE; // Une graine en sortie
+const int NN_MAX_CORRECTION = 8;                // Correction bornee (graines) : la recherche peut s'en passer hors fenetre
+
+// --- FORMAT DU FICHIER (petit-boutiste) ---
+//   NetHeader (32 octets) puis NetWeights tel quel (couche par couche, sans trou)
+struct NetHeader {
+    char magic[8];        // "MNCLNNET"
+    uint32_t version;
+    uint32_t pitsPerSide; // Variante sur laquelle le reseau a ete entraine
+    uint32_t seedsPerPit;
+    uint32_t rules;       // CaptureRule de la variante
+    uint32_t inputs;      // NN_INPUTS, NN_HIDDEN1, NN_HIDDEN2 (verifies au chargement)
+    uint16_t hidden1;
+    uint16_t hidden2;
+};
+static_assert(sizeof(NetHeader) == 32, "En-tete de reseau sur 32 octets");
+
+struct alignas(64) NetWeights {
+    int16_t w1[NN_INPUTS][NN_HIDDEN1];      // Une ligne par entree (ajoutee a l'accumulateur)
+    int16_t b1[NN_HIDDEN1];
+    int8_t w2[NN_HIDDEN2][2 * NN_HIDDEN1];  // Une ligne par neurone
+    int32_t b2[NN_HIDDEN2];
+    int8_t w3[NN_HIDDEN2];
+    int32_t b3;
+};
+static_assert(sizeof(NetWeights) == 18688, "Poids sans octets de bourrage internes");
+
+const char NET_MAGIC[8] = {'M', 'N', 'C', 'L', 'N', 'N', 'E', 'T'};
+const uint32_t NET_VERSION = 1;
+
+// Couche 1 des deux points de vue (indice = joueur)
+struct alignas(32) NnAccumulator {
+    int16_t v[2][NN_HIDDEN1];
+};
+
+inline int NnBucket(int seeds) { return seeds < NN_BUCKETS - 1 ? seeds : NN_BUCKETS - 1; }
+
+// Entree (trou, graines) vue depuis le camp de 'perspective'
+template <class B>
+inline int NnFeature(int perspective, int pit, int seeds) {
+    static_assert(B::NUM_PITS <= NN_MAX_PITS, "Trop de trous pour le reseau");
+    int rel = pit - B::FirstPitOf(perspective);
+    if (rel < 0) rel += B::NUM_PITS;
+    return rel * NN_BUCKETS + NnBucket(seeds);
+}
+
+// Trous dont le nombre de graines differe (un bit par trou)
+template <class B>
+inline uint32_t NnChangedPits(const B& before, const B& after) {
+    uint32_t changed = 0;
+    for (int pit = 0; pit < B::NUM_PITS; pit++) changed |= (uint32_t)(before.seeds[pit] != after.seeds[pit]) << pit;
+    return changed;
+}
+
+// --- NOYAUX (scalaire, SSSE3, AVX2) ---
+// ReLU bornee : accumulateur int16 -> activation 0..127
+inline uint8_t NnClip(int v) { return (uint8_t)(v < 0 ? 0 : v > NN_ACT_ONE ? NN_ACT_ONE : v); }
+
+inline int NnForwardScalar(const NetWeights& w, const NnAccumulator& acc, int side) {
+    uint8_t x[2 * NN_HIDDEN1];
+    for (int j = 0; j < NN_HIDDEN1; j++) {
+        x[j] = NnClip(acc.v[side][j]);
+        x[NN_HIDDEN1 + j] = NnClip(acc.v[1 - side][j]);
+    }
+    int out = w.b3;
+    for (int k = 0; k < NN_HIDDEN2; k++) {
+        int s = w.b2[k];
+        for (int i = 0; i < 2 * NN_HIDDEN1; i++) s += x[i] * w.w2[k][i];
+        out += NnClip(s >> NN_WEIGHT_SHIFT) * w.w3[k];
+    }
+    return out;
+}
+
+// Ajoute les lignes 'add' et retire les lignes 'sub' (count chacune) a un point de vue
+inline void NnUpdateScalar(const NetWeights& w, int16_t* v, const int* add, const int* sub, int count) {
+    for (int c = 0; c < count; c++) {
+        for (int j = 0; j < NN_HIDDEN1; j++) v[j] = (int16_t)(v[j] + w.w1[add[c]][j] - w.w1[sub[c]][j]);
+    }
+}
+
+#if MANCALA_SIMD_X86
+// u8 x s8 par paires puis sommes int32 (pas de saturation : |127 x 128| x 2 < 32768)
+MANCALA_TARGET("ssse3") inline __m128i NnDot16(__m128i x, const int8_t* w) {
+    return _mm_madd_epi16(_mm_maddubs_epi16(x, _mm_loadu_si128((const __m128i*)w)), _mm_set1_epi16(1));
+}
+
+MANCALA_TARGET("ssse3") inline int NnForwardSsse3(const NetWeights& w, const NnAccumulator& acc, int side) {
+    const __m128i one = _mm_set1_epi8(NN_ACT_ONE);
+    __m128i x[4];
+    for (int h = 0; h < 2; h++) {
+        const int16_t* a = acc.v[h == 0 ? side : 1 - side];
+        for (int q = 0; q < 2; q++) {
+            __m128i lo = _mm_load_si128((const __m128i*)(a + 16 * q));
+            __m128i hi = _mm_load_si128((const __m128i*)(a + 16 * q + 8));
+            x[2 * h + q] = _mm_min_epu8(_mm_packus_epi16(lo, hi), one);
+        }
+    }
+    __m128i sums[NN_HIDDEN2 / 4];
+    for (int k = 0; k < NN_HIDDEN2; k += 4) {
+        __m128i s[4];
+        for (int r = 0; r < 4; r++) {
+            const int8_t* row = w.w2[k + r];
+            s[r] = _mm_add_epi32(_mm_add_epi32(NnDot16(x[0], row), NnDot16(x[1], row + 16)),
+                                 _mm_add_epi32(NnDot16(x[2], row + 32), NnDot16(x[3], row + 48)));
+        }
+        __m128i t = _mm_hadd_epi32(_mm_hadd_epi32(s[0], s[1]), _mm_hadd_epi32(s[2], s[3]));
+        t = _mm_add_epi32(t, _mm_loadu_si128((const __m128i*)(w.b2 + k)));
+        sums[k / 4] = _mm_srai_epi32(t, NN_WEIGHT_SHIFT);
+    }
+    __m128i h0 = _mm_min_epu8(_mm_packus_epi16(_mm_packs_epi32(sums[0], sums[1]), _mm_packs_epi32(sums[2], sums[3])), one);
+    __m128i h1 = _mm_min_epu8(_mm_packus_epi16(_mm_packs_epi32(sums[4], sums[5]), _mm_packs_epi32(sums[6], sums[7])), one);
+    __m128i o = _mm_add_epi32(NnDot16(h0, w.w3), NnDot16(h1, w.w3 + 16));
+    o = _mm_hadd_epi32(o, o);
+    o = _mm_hadd_epi32(o, o);
+    return w.b3 + _mm_cvtsi128_si32(o);
+}
+
+MANCALA_TARGET("avx2") inline __m256i NnDot32(__m256i x, const int8_t* w) {
+    return _mm256_madd_epi16(_mm256_maddubs_epi16(x, _mm256_loadu_si256((const __m256i*)w)), _mm256_set1_epi16(1));
+}
+
+MANCALA_TARGET("avx2") inline int NnForwardAvx2(const NetWeights& w, const NnAccumulator& acc, int side) {
+    const __m256i one = _mm256_set1_epi8(NN_ACT_ONE);
+    __m256i x[2];
+    for (int h = 0; h < 2; h++) {
+        const int16_t* a = acc.v[h == 0 ? side : 1 - side];
+        __m256i packed = _mm256_packus_epi16(_mm256_load_si256((const __m256i*)a), _mm256_load_si256((const __m256i*)(a + 16)));
+        x[h] = _mm256_min_epu8(_mm256_permute4x64_epi64(packed, 0xD8), one); // packus entrelace les moities
+    }
+    __m128i sums[NN_HIDDEN2 / 4];
+    for (int k = 0; k < NN_HIDDEN2; k += 4) {
+        __m256i s[4];
+        for (int r = 0; r < 4; r++) s[r] = _mm256_add_epi32(NnDot32(x[0], w.w2[k + r]), NnDot32(x[1], w.w2[k + r] + 32));
+        __m256i t = _mm256_hadd_epi32(_mm256_hadd_epi32(s[0], s[1]), _mm256_hadd_epi32(s[2], s[3]));
+        __m128i u = _mm_add_epi32(_mm256_castsi256_si128(t), _mm256_extracti128_si256(t, 1));
+        u = _mm_add_epi32(u, _mm_loadu_si128((const __m128i*)(w.b2 + k)));
+        sums[k / 4] = _mm_srai_epi32(u, NN_WEIGHT_SHIFT);
+    }
+    const __m128i one128 = _mm_set1_epi8(NN_ACT_ONE);
+    __m128i h0 = _mm_min_epu8(_mm_packus_epi16(_mm_packs_epi32(sums[0], sums[1]), _mm_packs_epi32(sums[2], sums[3])), one128);
+    __m128i h1 = _mm_min_epu8(_mm_packus_epi16(_mm_packs_epi32(sums[4], sums[5]), _mm_packs_epi32(sums[6], sums[7])), one128);
+    __m256i o = NnDot32(_mm256_set_m128i(h1, h0), w.w3);
+    __m128i p = _mm_add_epi32(_mm256_castsi256_si128(o), _mm256_extracti128_si256(o, 1));
+    p = _mm_hadd_epi32(p, p);
+    p = _mm_hadd_epi32(p, p);
+    return w.b3 + _mm_cvtsi128_si32(p);
+}
+
+// Les deux points de vue en une passe, de 'from' vers 'to' (sans copie prealable).
+// Trous modifies en une comparaison d'octets, lignes de poids lues au fil des bits :
+// ni tableau d'indices intermediaire, ni branchement par trou.
+template <class B>
+MANCALA_TARGET("avx2") inline void NnUpdateAvx2(const NetWeights& w, const NnAccumulator& from, const B& before, const B& after,
+                                                NnAccumulator& to) {
+    uint32_t changed;
+    if (B::NUM_PITS >= 8) { // Deux lectures de 8 octets qui se chevauchent couvrent les trous
+        uint64_t b[2], a[2];
+        std::memcpy(&b[0], before.seeds, 8);
+        std::memcpy(&b[1], before.seeds + B::NUM_PITS - 8, 8);
+        std::memcpy(&a[0], after.seeds, 8);
+        std::memcpy(&a[1], after.seeds + B::NUM_PITS - 8, 8);
+        __m128i same = _mm_cmpeq_epi8(_mm_set_epi64x((long long)b[1], (long long)b[0]), _mm_set_epi64x((long long)a[1], (long long)a[0]));
+        uint32_t bits = (uint32_t)_mm_movemask_epi8(same);
+        changed = ~((bits & 0xFF) | ((bits >> 8) << (B::NUM_PITS - 8))) & ((1u << B::NUM_PITS) - 1);
+    } else {
+        changed = NnChangedPits(before, after);
+    }
+    __m256i v[4];
+    for (int q = 0; q < 4; q++) v[q] = _mm256_load_si256((const __m256i*)(from.v[q / 2] + 16 * (q % 2)));
+    for (; changed; changed &= changed - 1) {
+        int pit = __builtin_ctz(changed);
+        int was = NnBucket(before.seeds[pit]);
+        int now = NnBucket(after.seeds[pit]);
+        for (int p = 0; p < 2; p++) {
+            int row = NnFeature<B>(p, pit, 0);
+            const int16_t* a = w.w1[row + now];
+            const int16_t* s = w.w1[row + was];
+            v[2 * p] = _mm256_sub_epi16(_mm256_add_epi16(v[2 * p], _mm256_load_si256((const __m256i*)a)), _mm256_load_si256((const __m256i*)s));
+            v[2 * p + 1] = _mm256_sub_epi16(_mm256_add_epi16(v[2 * p + 1], _mm256_load_si256((const __m256i*)(a + 16))),
+                                            _mm256_load_si256((const __m256i*)(s + 16)));
+        }
+    }
+    for (int q = 0; q < 4; q++) _mm256_store_si256((__m256i*)(to.v[q / 2] + 16 * (q % 2)), v[q]);
+}
+#endif
+
+// --- RESEAU ---
+class NeuralNet {
+public:
+    bool Open(const std::string& path) {
+        Close();
+        MappedFile file;
+        if (!file.Open(path)) {
+            std::cerr << "Reseau d'evaluation introuvable : " << path << std::endl;
+            return false;
+        }
+        if (file.Size() != sizeof(NetHeader) + sizeof(NetWeights)) return Fail(path, "taille incoherente");
+        std::memcpy(&header, file.Data(), sizeof(header));
+        if (std::memcmp(header.magic, NET_MAGIC, 8) != 0) return Fail(path, "signature inconnue");
+        if (header.version != NET_VERSION) return Fail(path, "version non geree");
+        if (header.inputs != (uint32_t)NN_INPUTS || header.hidden1 != NN_HIDDEN1 || header.hidden2 != NN_HIDDEN2)
+            return Fail(path, "dimensions differentes");
+        weights.reset(new NetWeights());
+        std::memcpy(weights.get(), file.Data() + sizeof(header), sizeof(NetWeights)); // Copie alignee pour les noyaux
+        // Sortie extreme possible : activations de la couche 3 a 0 ou 1 selon le signe du poids
+        int low = weights->b3, high = weights->b3;
+        for (int k = 0; k < NN_HIDDEN2; k++) (weights->w3[k] < 0 ? low : high) += NN_ACT_ONE * weights->w3[k];
+        minCorrection = Correction(low);
+        maxCorrection = Correction(high);
+        return true;
+    }
+
+    void Close() { weights.reset(); }
+
+    bool IsOpen() const { return weights != nullptr; }
+
+    template <class B>
+    bool IsFor() const {
+        return IsOpen() && header.pitsPerSide == (uint32_t)B::PITS_PER_SIDE && header.seedsPerPit == (uint32_t)B::SEEDS_PER_PIT
+            && header.rules == (uint32_t)B::Rules::CAPTURE;
+    }
+
+    // Accumulateur recalcule depuis zero (racine d'une recherche)
+    template <class B>
+    void Refresh(const B& b, NnAccumulator& acc) const {
+        const NetWeights& w = *weights;
+        for (int p = 0; p < 2; p++) {
+            for (int j = 0; j < NN_HIDDEN1; j++) acc.v[p][j] = w.b1[j];
+            for (int pit = 0; pit < B::NUM_PITS; pit++) {
+                const int16_t* row = w.w1[NnFeature<B>(p, pit, b.seeds[pit])];
+                for (int j = 0; j < NN_HIDDEN1; j++) acc.v[p][j] = (int16_t)(acc.v[p][j] + row[j]);
+            }
+        }
+    }
+
+    // Accumulateur de 'after' a partir de celui de 'before' : seuls les trous modifies comptent
+    template <class B>
+    void Update(const NnAccumulator& from, const B& before, const B& after, NnAccumulator& to) const {
+#if MANCALA_SIMD_X86
+        if (ActiveSimdLevel() == SIMD_AVX2) { NnUpdateAvx2(*weights, from, before, after, to); return; }
+#endif
+        int add[2][NN_MAX_PITS], sub[2][NN_MAX_PITS];
+        // Trous modifies en masque, puis parcourus bit a bit ;
+        // un trou reste dans la case "15 et plus" : lignes ajoutee et retiree identiques
+        int count = 0;
+        for (uint32_t changed = NnChangedPits(before, after); changed; changed &= changed - 1, count++) {
+            int pit = __builtin_ctz(changed);
+            for (int p = 0; p < 2; p++) {
+                int row = NnFeature<B>(p, pit, 0);
+                add[p][count] = row + NnBucket(after.seeds[pit]);
+                sub[p][count] = row + NnBucket(before.seeds[pit]);
+            }
+        }
+        to = from;
+        for (int p = 0; p < 2; p++) NnUpdateScalar(*weights, to.v[p], add[p], sub[p], count);
+    }
+
+    // Sortie brute (NN_OUTPUT_ONE par graine), vue du joueur 'side'
+    int Forward(const NnAccumulator& acc, int side) const {
+#if MANCALA_SIMD_X86
+        switch (ActiveSimdLevel()) {
+        case SIMD_AVX2:  return NnForwardAvx2(*weights, acc, side);
+        case SIMD_SSSE3: return NnForwardSsse3(*weights, acc, side);
+        default: break;
+        }
+#endif
+        return NnForwardScalar(*weights, acc, side);
+    }
+
+    // Score en graines du joueur au trait : difference de magasins + correction du reseau
+    template <class B>
+    int Evaluate(const B& b, const NnAccumulator& acc) const {
+        int me = b.sideToMove;
+        return b.seeds[B::StoreOf(me)] - b.seeds[B::StoreOf(1 - me)] + Correction(Forward(acc, me));
+    }
+
+    // Correction que ce reseau peut donner au plus (graines) : bornes des coupures de la recherche
+    int MinCorrection() const { return minCorrection; }
+    int MaxCorrection() const { return maxCorrection; }
+
+    const NetWeights& Weights() const { return *weights; }
+
+private:
+    // Sortie brute -> graines, arrondie et bornee a NN_MAX_CORRECTION
+    static int Correction(int out) {
+        int correction = (out >= 0 ? out + NN_OUTPUT_ONE / 2 : out - NN_OUTPUT_ONE / 2) / NN_OUTPUT_ONE;
+        if (correction > NN_MAX_CORRECTION) correction = NN_MAX_CORRECTION;
+        if (correction < -NN_MAX_CORRECTION) correction = -NN_MAX_CORRECTION;
+        return correction;
+    }
+
+    bool Fail(const std::string& path, const char* why) {
+        std::cerr << "Reseau d'evaluation invalide (" << why << ") : " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    NetHeader header = {};
+    std::unique_ptr<NetWeights> weights;
+    int minCorrection = -NN_MAX_CORRECTION, maxCorrection = NN_MAX_CORRECTION;
+};
+
+// Ecrit un reseau (entraineur : mancala-headless train)
+template <class B>
+bool WriteNet(const std::string& path, const NetWeights& weights) {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out) { std::cerr << "Impossible d'ecrire " << path << std::endl; return false; }
+    NetHeader h = {};
+    std::memcpy(h.magic, NET_MAGIC, 8);
+    h.version = NET_VERSION;
+    h.pitsPerSide = B::PITS_PER_SIDE;
+    h.seedsPerPit = B::SEEDS_PER_PIT;
+    h.rules = (uint32_t)B::Rules::CAPTURE;
+    h.inputs = NN_INPUTS;
+    h.hidden1 = NN_HIDDEN1;
+    h.hidden2 = NN_HIDDEN2;
+    out.write((const char*)&h, sizeof(h));
+    out.write((const char*)&weights, sizeof(weights));
+    return (bool)out;
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef NOTATION_HPP
+#define NOTATION_HPP
+
+#include <string>
+#include <sstream>
+#include <cctype>
+
+#include "Board.hpp"
+
+// Notation texte d'une position : les NUM_PITS compteurs dans l'ordre des
+// indices puis le joueur au trait (0 = Bas, 1 = Haut), separes par des
+// espaces ou des virgules. Depart du Kalah(6,4) :
+//   4,4,4,4,4,4,0,4,4,4,4,4,4,0 0
+
+template <class B>
+bool ParsePosition(const std::string& text, B& out) {
+    std::string cleaned = text;
+    for (char& c : cleaned) {
+        if (c == ',' || c == ';' || c == '/') c = ' ';
+        else if (!std::isdigit((unsigned char)c) && !std::isspace((unsigned char)c)) return false;
+    }
+    std::istringstream in(cleaned);
+    int values[B::NUM_PITS + 1];
+    int n = 0, v;
+    while (in >> v) {
+        if (n > B::NUM_PITS || v < 0 || v > 255) return false;
+        values[n++] = v;
+    }
+    if (n != B::NUM_PITS + 1 || values[B::NUM_PITS] > 1) return false;
+
+    int total = 0;
+    for (int i = 0; i < B::NUM_PITS; i++) {
+        out.seeds[i] = (uint8_t)values[i];
+        total += values[i];
+    }
+    out.sideToMove = (uint8_t)values[B::NUM_PITS];
+    return total == B::TOTAL_SEEDS; // Les graines ne se creent ni ne se perdent
+}
+
+template <class B>
+std::string FormatPosition(const B& b) {
+    std::string s;
+    for (int i = 0; i < B::NUM_PITS; i++) {
+        if (i > 0) s += ',';
+        s += std::to_string(b.seeds[i]);
+    }
+    return s + " " + std::to_string(b.sideToMove);
+}
+
+#endif
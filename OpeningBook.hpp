@@ -0,0 +1,202 @@
+#ifndef OPENINGBOOK_HPP
+#define OPENINGBOOK_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Board.hpp"
+#include "MappedFile.hpp"
+#include "Search.hpp"
+#include "Zobrist.hpp"
+
+// Livre d'ouvertures : le meilleur coup de chaque position des premiers
+// demi-coups, calcule une fois pour toutes par des recherches profondes.
+// Le fichier est une table triee par hash de Zobrist : le jeu le projette
+// en memoire et y cherche par dichotomie, sans rien decoder.
+
+// --- FORMAT DU FICHIER (petit-boutiste) ---
+//   BookHeader (32 octets) puis entryCount BookEntry (16 octets) triees par cle
+struct BookHeader {
+    char magic[8];        // "MNCLBOOK"
+    uint32_t version;
+    uint32_t pitsPerSide; // Variante : les cles n'ont de sens que pour elle
+    uint32_t seedsPerPit;
+    uint32_t rules;       // CaptureRule de la variante
+    uint64_t entryCount;
+};
+static_assert(sizeof(BookHeader) == 32, "En-tete de livre sur 32 octets");
+
+struct BookEntry {
+    uint64_t key;      // HashPosition
+    int32_t score;     // Score de la recherche, vu du joueur au trait
+    uint8_t move;      // Meilleur coup (indice du trou)
+    uint8_t depth;     // Profondeur de la recherche
+    uint16_t reserved;
+};
+static_assert(sizeof(BookEntry) == 16, "Entree de livre sur 16 octets");
+
+const char BOOK_MAGIC[8] = {'M', 'N', 'C', 'L', 'B', 'O', 'O', 'K'};
+const uint32_t BOOK_VERSION = 1;
+
+// --- LECTURE (fichier projete en memoire) ---
+class OpeningBook {
+public:
+    bool Open(const std::string& path) {
+        Close();
+        if (!file.Open(path)) {
+            std::cerr << "Livre d'ouvertures introuvable : " << path << std::endl;
+            return false;
+        }
+        if (file.Size() < sizeof(BookHeader)) return Fail(path, "fichier trop court");
+        std::memcpy(&header, file.Data(), sizeof(header));
+        if (std::memcmp(header.magic, BOOK_MAGIC, 8) != 0) return Fail(path, "signature inconnue");
+        if (header.version != BOOK_VERSION) return Fail(path, "version non geree");
+        if (file.Size() < sizeof(header) + header.entryCount * sizeof(BookEntry)) return Fail(path, "taille incoherente");
+        // En-tete de 32 octets sur une page alignee : les entrees sont lisibles en place
+        entries = (const BookEntry*)(file.Data() + sizeof(header));
+        return true;
+    }
+
+    void Close() {
+        file.Close();
+        entries = nullptr;
+    }
+
+    bool IsOpen() const { return entries != nullptr; }
+    size_t Size() const { return IsOpen() ? (size_t)header.entryCount : 0; }
+
+    template <class B>
+    bool IsFor() const {
+        return IsOpen() && header.pitsPerSide == (uint32_t)B::PITS_PER_SIDE && header.seedsPerPit == (uint32_t)B::SEEDS_PER_PIT
+            && header.rules == (uint32_t)B::Rules::CAPTURE;
+    }
+
+    // Dichotomie sur les cles triees (nullptr si absente)
+    const BookEntry* Find(uint64_t key) const {
+        if (!IsOpen()) return nullptr;
+        const BookEntry* first = entries;
+        const BookEntry* last = entries + header.entryCount;
+        const BookEntry* it = std::lower_bound(first, last, key, [](const BookEntry& e, uint64_t k) { return e.key < k; });
+        return (it != last && it->key == key) ? it : nullptr;
+    }
+
+private:
+    bool Fail(const std::string& path, const char* why) {
+        std::cerr << "Livre d'ouvertures invalide (" << why << ") : " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    MappedFile file;
+    BookHeader header = {};
+    const BookEntry* entries = nullptr;
+};
+
+// Coup du livre pour 'b' (verifie legal : une collision de hash ne fait pas jouer n'importe quoi)
+template <class B>
+inline bool ProbeBook(const OpeningBook& book, const B& b, BookEntry& out) {
+    if (!book.IsFor<B>()) return false;
+    const BookEntry* e = book.Find(HashPosition(b));
+    if (!e || !IsLegalMove(b, e->move)) return false;
+    out = *e;
+    return true;
+}
+
+// --- GENERATION (outil hors ligne) ---
+// Pour chaque camp tour a tour : quand c'est a lui on ne suit que le coup trouve,
+// quand c'est a l'adversaire on suit toutes ses reponses. Le livre couvre ainsi
+// toutes les lignes adverses sans exploser comme l'arbre complet.
+struct BookConfig {
+    int plies = 8;    // Demi-coups couverts depuis la position de depart
+    int depth = 12;   // Profondeur de recherche par position
+    int threads = 0;  // 0 = tous les coeurs
+    int hashMb = 16;  // Table de transposition par thread
+};
+
+// Recherche en parallele les positions d'un niveau
+template <class B>
+void SearchBookPositions(const std::vector<B>& positions, const BookConfig& cfg, std::vector<BookEntry>& out) {
+    size_t base = out.size();
+    out.resize(base + positions.size());
+    std::atomic<size_t> next(0);
+    int threadCount = cfg.threads > 0 ? cfg.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&]() {
+            TranspositionTable tt(cfg.hashMb);
+            SearchLimits limits;
+            limits.maxDepth = cfg.depth;
+            for (size_t i = next++; i < positions.size(); i = next++) {
+                SearchResult r = SearchPosition(positions[i], limits, &tt);
+                BookEntry& e = out[base + i];
+                e.key = HashPosition(positions[i]);
+                e.score = r.score;
+                e.move = (uint8_t)r.bestMove;
+                e.depth = (uint8_t)r.depth;
+                e.reserved = 0;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+template <class B>
+std::vector<BookEntry> BuildBook(const BookConfig& cfg) {
+    std::vector<BookEntry> entries;
+    std::unordered_map<uint64_t, size_t> known; // hash -> indice dans 'entries'
+
+    for (int bookSide = 0; bookSide < 2; bookSide++) {
+        std::vector<B> level(1, B::Initial());
+        for (int ply = 0; ply <= cfg.plies && !level.empty(); ply++) {
+            // Positions nouvelles de ce niveau (deja cherchees pour l'autre camp : reutilisees)
+            std::vector<B> fresh;
+            for (const B& b : level) {
+                if (known.emplace(HashPosition(b), entries.size() + fresh.size()).second) fresh.push_back(b);
+            }
+            SearchBookPositions(fresh, cfg, entries);
+            if (ply == cfg.plies) break;
+
+            std::vector<B> nextLevel;
+            std::unordered_map<uint64_t, int> queued;
+            for (const B& b : level) {
+                typename B::MoveList moves = LegalMoves(b);
+                for (int i = 0; i < moves.count; i++) {
+                    if (b.sideToMove == bookSide && moves.moves[i] != entries[known[HashPosition(b)]].move) continue;
+                    B child = b;
+                    ApplyMove(child, moves.moves[i]);
+                    if (!IsTerminal(child) && queued.emplace(HashPosition(child), 0).second) nextLevel.push_back(child);
+                }
+            }
+            level.swap(nextLevel);
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const BookEntry& a, const BookEntry& b) { return a.key < b.key; });
+    return entries;
+}
+
+template <class B>
+bool WriteBook(const std::string& path, const std::vector<BookEntry>& entries) {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out) { std::cerr << "Impossible d'ecrire " << path << std::endl; return false; }
+    BookHeader h = {};
+    std::memcpy(h.magic, BOOK_MAGIC, 8);
+    h.version = BOOK_VERSION;
+    h.pitsPerSide = B::PITS_PER_SIDE;
+    h.seedsPerPit = B::SEEDS_PER_PIT;
+    h.rules = (uint32_t)B::Rules::CAPTURE;
+    h.entryCount = entries.size();
+    out.write((const char*)&h, sizeof(h));
+    out.write((const char*)entries.data(), (std::streamsize)(entries.size() * sizeof(BookEntry)));
+    return (bool)out;
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef PERFT_HPP
+#define PERFT_HPP
+
+#include <cstdint>
+
+#include "Board.hpp"
+#include "MoveLog.hpp"
+
+// Perft : nombre de positions atteintes en exactement 'depth' demi-coups.
+// Un coup qui fait rejouer compte comme un demi-coup du meme joueur ;
+// une partie finie avant 'depth' ne produit aucune feuille.
+
+template <class B>
+uint64_t Perft(const B& b, int depth) {
+    if (depth == 0) return 1;
+    if (IsTerminal(b)) return 0;
+
+    typename B::MoveList moves = LegalMoves(b);
+    if (depth == 1) return (uint64_t)moves.count; // Comptage en bloc des feuilles
+
+    uint64_t nodes = 0;
+    for (int i = 0; i < moves.count; i++) {
+        B child = b;
+        ApplyMove(child, moves.moves[i]);
+        nodes += Perft(child, depth - 1);
+    }
+    return nodes;
+}
+
+// Meme compte en jouant / defaisant les coups sur un seul plateau (MakeMove / UnmakeMove).
+// Verifie UnmakeMove : 'b' doit ressortir intact et les comptes egaux a ceux de Perft.
+template <class B>
+uint64_t PerftUnmake(B& b, int depth) {
+    if (depth == 0) return 1;
+    if (IsTerminal(b)) return 0;
+
+    typename B::MoveList moves = LegalMoves(b);
+    if (depth == 1) return (uint64_t)moves.count;
+
+    uint64_t nodes = 0;
+    MoveUndo<B> undo;
+    for (int i = 0; i < moves.count; i++) {
+        MakeMove(b, moves.moves[i], undo);
+        nodes += PerftUnmake(b, depth - 1);
+        UnmakeMove(b, undo);
+    }
+    return nodes;
+}
+
+// --- VALEURS DE REFERENCE (depuis la position de depart, index = profondeur) ---
+// Toute modification de la distribution, des captures, du saut de magasin
+// ou du ramassage final qui change ces nombres est une regression.
+
+template <class B>
+struct PerftReference {
+    static constexpr int COUNT = 0;
+    static constexpr uint64_t VALUES[1] = {1};
+};
+
+template <>
+struct PerftReference<Kalah6x4> {
+    static constexpr int COUNT = 13;
+    static constexpr uint64_t VALUES[COUNT] = {
+        1ULL, 6ULL, 35ULL, 185ULL, 942ULL, 4690ULL, 23233ULL, 114430ULL, 563055ULL,
+        2763490ULL, 13519607ULL, 65870758ULL, 318739550ULL
+    };
+};
+
+template <>
+struct PerftReference<Kalah6x6> {
+    static constexpr int COUNT = 12;
+    static constexpr uint64_t VALUES[COUNT] = {
+        1ULL, 6ULL, 35ULL, 190ULL, 1056ULL, 5882ULL, 32243ULL, 177827ULL, 962153ULL,
+        5197521ULL, 27673819ULL, 146117172ULL
+    };
+};
+
+template <>
+struct PerftReference<Oware6x4> {
+    static constexpr int COUNT = 13;
+    static constexpr uint64_t VALUES[COUNT] = {
+        1ULL, 6ULL, 36ULL, 190ULL, 1014ULL, 5219ULL, 27332ULL, 139157ULL, 711414ULL,
+        3592872ULL, 18137964ULL, 91558687ULL, 460005710ULL
+    };
+};
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef POLICIES_HPP
+#define POLICIES_HPP
+
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Board.hpp"
+#include "Mcts.hpp"
+#include "Rng.hpp"
+#include "Search.hpp"
+
+// Joueurs automatiques pour les parties sans fenetre (auto-jeu, tournois...)
+enum PolicyKind {
+    POLICY_RANDOM, // Coup legal au hasard
+    POLICY_GREEDY, // Meilleur gain immediat (magasin + rejoue)
+    POLICY_SEARCH, // Recherche alpha-beta (profondeur fixe ou temps par coup)
+    POLICY_MCTS    // Monte Carlo Tree Search (playouts ou temps par coup)
+};
+
+struct PolicyConfig {
+    PolicyKind kind = POLICY_RANDOM;
+    int depth = 6;  // Profondeur pour POLICY_SEARCH
+    int timeMs = 0; // Si > 0 : approfondissement iteratif (ou MCTS) limite a timeMs par coup
+    long iterations = 2000; // Playouts par coup pour POLICY_MCTS
+    bool weighted = false;  // POLICY_SEARCH : evaluation ponderee par 'weights'
+    EvalWeights weights;
+    bool neural = false;    // POLICY_SEARCH : evaluation par le reseau 'net' (":nn")
+    const NeuralNet* net = nullptr; // Fourni par l'appelant (fichier --net) ; sans lui ":nn" ne change rien
+};
+
+// Travail d'un coup (pour comparer les vitesses)
+struct MoveStats {
+    uint64_t nodes = 0;  // Noeuds (alpha-beta) ou playouts (MCTS)
+    double seconds = 0.0;
+};
+
+// "random", "greedy", "search", "search:8" (profondeur), "search:100ms" (temps),
+// "mcts", "mcts:5000" (playouts) ou "mcts:100ms" (temps).
+// Alpha-beta : ":eval=S,O,A,C" en plus donne les poids de l'evaluation
+// (EvalWeights, en quarts de graine), ex. "search:8:eval=4,1,-1,2" ;
+// ":nn" l'evaluation par le reseau (NeuralEval.hpp), ex. "search:8:nn".
+inline bool ParsePolicy(const std::string& text, PolicyConfig& out) {
+    std::string name = text.substr(0, text.find(':'));
+    if (name == "random") out.kind = POLICY_RANDOM;
+    else if (name == "greedy") out.kind = POLICY_GREEDY;
+    else if (name == "search") out.kind = POLICY_SEARCH;
+    else if (name == "mcts") out.kind = POLICY_MCTS;
+    else return false;
+    for (size_t colon = text.find(':'); colon != std::string::npos; colon = text.find(':', colon + 1)) {
+        std::string arg = text.substr(colon + 1, text.find(':', colon + 1) - colon - 1);
+        if (arg == "nn") {
+            if (out.kind != POLICY_SEARCH) return false;
+            out.neural = true;
+            continue;
+        }
+        if (arg.compare(0, 5, "eval=") == 0) {
+            if (out.kind != POLICY_SEARCH) return false;
+            int w[4];
+            if (std::sscanf(arg.c_str() + 5, "%d,%d,%d,%d", &w[0], &w[1], &w[2], &w[3]) != 4) return false;
+            out.weights.store = w[0]; out.weights.ownSeeds = w[1]; out.weights.otherSeeds = w[2]; out.weights.captures = w[3];
+            out.weighted = true;
+            continue;
+        }
+        bool isTime = arg.size() > 2 && arg.compare(arg.size() - 2, 2, "ms") == 0;
+        int value = std::atoi(arg.c_str());
+        if (value < 1) return false;
+        if (isTime) out.timeMs = value;
+        else if (out.kind == POLICY_MCTS) out.iterations = value;
+        else out.depth = value;
+    }
+    return true;
+}
+
+inline std::string PolicyName(const PolicyConfig& p) {
+    if (p.kind == POLICY_RANDOM) return "random";
+    if (p.kind == POLICY_GREEDY) return "greedy";
+    std::string name = p.kind == POLICY_MCTS ? "mcts:" : "search:";
+    if (p.timeMs > 0) name += std::to_string(p.timeMs) + "ms";
+    else if (p.kind == POLICY_MCTS) name += std::to_string(p.iterations);
+    else name += std::to_string(p.depth);
+    if (p.weighted) {
+        name += ":eval=" + std::to_string(p.weights.store) + "," + std::to_string(p.weights.ownSeeds) + ","
+              + std::to_string(p.weights.otherSeeds) + "," + std::to_string(p.weights.captures);
+    }
+    if (p.neural) name += ":nn";
+    return name;
+}
+
+// Gain immediat d'un coup pour celui qui le joue
+template <class B>
+inline int GreedyScore(const B& b, int move) {
+    int me = b.sideToMove;
+    B child = b;
+    MoveResult r = ApplyMove(child, move);
+    int score = 4 * (child.seeds[B::StoreOf(me)] - b.seeds[B::StoreOf(me)]);
+    if (r.extraTurn) score += 3;
+    if (r.gameOver) score += Winner(child) == me ? 1000 : -1000;
+    return score;
+}
+
+// Choix du coup selon la politique (-1 si aucun coup legal).
+// 'tt' (optionnelle) sert a l'alpha-beta, 'arena' (optionnelle) au MCTS ;
+// 'stats' (optionnel) recoit le travail de la recherche.
+template <class B>
+int ChooseMove(const B& b, const PolicyConfig& policy, Rng& rng, TranspositionTable* tt = nullptr,
+               MctsArena* arena = nullptr, MoveStats* stats = nullptr) {
+    typename B::MoveList moves = LegalMoves(b);
+    if (moves.count == 0) return -1;
+
+    if (policy.kind == POLICY_SEARCH) {
+        SearchLimits limits;
+        if (policy.timeMs > 0) limits.timeLimitMs = policy.timeMs;
+        else limits.maxDepth = policy.depth;
+        if (policy.weighted) limits.weights = &policy.weights;
+        if (policy.neural) limits.net = policy.net;
+        SearchResult r = SearchPosition(b, limits, tt);
+        if (stats) { stats->nodes = r.nodes; stats->seconds = r.seconds; }
+        return r.bestMove;
+    }
+
+    if (policy.kind == POLICY_MCTS) {
+        MctsLimits limits;
+        if (policy.timeMs > 0) limits.timeLimitMs = policy.timeMs;
+        else limits.iterations = policy.iterations;
+        limits.seed = rng.Next();
+        MctsResult r;
+        if (arena) r = MctsSearch(b, limits, *arena);
+        else {
+            MctsArena local((size_t)(policy.timeMs > 0 ? 1 << 20 : policy.iterations * B::PITS_PER_SIDE + 1));
+            r = MctsSearch(b, limits, local);
+        }
+        if (stats) { stats->nodes = (uint64_t)r.iterations; stats->seconds = r.seconds; }
+        return r.bestMove;
+    }
+
+    if (policy.kind == POLICY_GREEDY) {
+        int best = -SCORE_INF, bestMove = -1, ties = 0;
+        for (int i = 0; i < moves.count; i++) {
+            int score = GreedyScore(b, moves.moves[i]);
+            if (score > best) { best = score; bestMove = moves.moves[i]; ties = 1; }
+            else if (score == best && rng.Below(++ties) == 0) bestMove = moves.moves[i]; // Egalites tirees au hasard
+        }
+        return bestMove;
+    }
+
+    return moves.moves[rng.Below(moves.count)];
+}
+
+#endif
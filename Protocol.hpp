@@ -0,0 +1,158 @@
+#ifndef PROTOCOL_HPP
+#define PROTOCOL_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Board.hpp"
+#include "MoveEvents.hpp"
+
+// Protocole binaire du serveur de parties (GameServer.hpp) et de ses clients
+// (jeu 3D en vue distante, generateur de charge). Chaque message est une trame :
+//   uint16 longueur (petit-boutiste, octets qui suivent) | uint8 type | charge utile
+// Le serveur decrit chaque coup par le flux d'evenements de MoveEvents.hpp :
+// le client l'anime tel quel, exactement comme un coup joue en local.
+
+const int NET_MAX_FRAME = 1024; // Longueur max d'une trame (le plus gros message fait ~300 octets)
+
+enum NetMessageType : uint8_t {
+    // Client -> serveur
+    MSG_JOIN = 1,           // uint8 adversaire : NET_OPPONENT_CLIENT ou NET_OPPONENT_AI
+    MSG_MOVE = 2,           // uint8 trou
+    MSG_LEAVE = 3,          // Quitte la partie en cours (la connexion reste ouverte)
+
+    // Serveur -> client
+    MSG_MATCH = 16,         // uint32 partie, uint8 place (0 = J1), uint8 adversaire, NUM_PITS octets, uint8 trait
+    MSG_EVENTS = 17,        // MoveEvent[] : deroulement d'un coup (le sien ou celui de l'adversaire)
+    MSG_ERROR = 18,         // uint8 NetError
+    MSG_OPPONENT_LEFT = 19  // L'adversaire est parti : la partie est finie
+};
+
+enum NetOpponent : uint8_t {
+    NET_OPPONENT_CLIENT, // Un autre client en attente
+    NET_OPPONENT_AI      // L'ordinateur du serveur
+};
+
+enum NetError : uint8_t {
+    NET_ERR_BAD_MESSAGE,
+    NET_ERR_NO_MATCH,     // Coup hors partie
+    NET_ERR_NOT_YOUR_TURN,
+    NET_ERR_ILLEGAL_MOVE,
+    NET_ERR_ALREADY_PLAYING
+};
+
+struct NetMessage {
+    uint8_t type;
+    const uint8_t* payload; // Valide jusqu'au prochain ajout dans le FrameBuffer
+    int size;
+};
+
+// Ajoute une trame a un tampon d'envoi
+inline void AppendFrame(std::vector<uint8_t>& out, uint8_t type, const void* payload = nullptr, int size = 0) {
+    int length = size + 1;
+    out.push_back((uint8_t)(length & 0xFF));
+    out.push_back((uint8_t)(length >> 8));
+    out.push_back(type);
+    if (size > 0) out.insert(out.end(), (const uint8_t*)payload, (const uint8_t*)payload + size);
+}
+
+// Octets recus, decoupes en trames completes
+class FrameBuffer {
+public:
+    void Append(const uint8_t* bytes, size_t count) {
+        if (start > 0 && start == data.size()) { data.clear(); start = 0; }
+        else if (start > 4096 && start * 2 > data.size()) { // Compaction : on ne garde que le non lu
+            data.erase(data.begin(), data.begin() + start);
+            start = 0;
+        }
+        data.insert(data.end(), bytes, bytes + count);
+    }
+
+    // Trame suivante si elle est complete. 'bad' : longueur invalide (il faut couper la connexion)
+    bool Next(NetMessage& out, bool& bad) {
+        bad = false;
+        size_t available = data.size() - start;
+        if (available < 2) return false;
+        int length = data[start] | (data[start + 1] << 8);
+        if (length < 1 || length > NET_MAX_FRAME) { bad = true; return false; }
+        if (available < (size_t)length + 2) return false;
+        out.type = data[start + 2];
+        out.payload = data.data() + start + 3;
+        out.size = length - 1;
+        start += (size_t)length + 2;
+        return true;
+    }
+
+    size_t Pending() const { return data.size() - start; }
+
+private:
+    std::vector<uint8_t> data;
+    size_t start = 0;
+};
+
+// --- MESSAGES ---
+template <class B>
+void AppendMatchFrame(std::vector<uint8_t>& out, uint32_t match, int seat, int opponent, const B& board) {
+    uint8_t payload[6 + B::NUM_PITS + 1];
+    for (int i = 0; i < 4; i++) payload[i] = (uint8_t)(match >> (8 * i));
+    payload[4] = (uint8_t)seat;
+    payload[5] = (uint8_t)opponent;
+    std::memcpy(payload + 6, board.seeds, B::NUM_PITS);
+    payload[6 + B::NUM_PITS] = board.sideToMove;
+    AppendFrame(out, MSG_MATCH, payload, (int)sizeof(payload));
+}
+
+template <class B>
+bool DecodeMatchFrame(const NetMessage& m, uint32_t& match, int& seat, int& opponent, B& board) {
+    if (m.type != MSG_MATCH || m.size != 6 + B::NUM_PITS + 1) return false;
+    match = 0;
+    for (int i = 0; i < 4; i++) match |= (uint32_t)m.payload[i] << (8 * i);
+    seat = m.payload[4];
+    opponent = m.payload[5];
+    std::memcpy(board.seeds, m.payload + 6, B::NUM_PITS);
+    board.sideToMove = m.payload[6 + B::NUM_PITS];
+    return seat < 2 && board.sideToMove < 2;
+}
+
+template <class B>
+void AppendEventsFrame(std::vector<uint8_t>& out, const MoveEventStream<B>& events) {
+    static_assert(sizeof(MoveEvent) == 4, "MoveEvent envoye tel quel sur 4 octets");
+    AppendFrame(out, MSG_EVENTS, events.events, events.count * (int)sizeof(MoveEvent));
+}
+
+// Evenement dont les champs restent dans le plateau : le client s'en sert comme indices
+template <class B>
+bool IsValidEvent(const MoveEvent& e) {
+    if (e.pit >= B::NUM_PITS || e.target >= B::NUM_PITS) return false;
+    switch (e.type) {
+    case EV_PICKUP:
+    case EV_SEED_DROPPED:
+    case EV_CAPTURE:
+        return true;
+    case EV_EXTRA_TURN:
+    case EV_TURN_PASSED:
+    case EV_SWEEP:
+        return e.pit < 2;  // Un joueur
+    case EV_GAME_OVER:
+        return e.pit <= 2; // Vainqueur ou egalite
+    }
+    return false;
+}
+
+// Chaque evenement est verifie ; qu'ils decrivent bien le coup sur le plateau
+// du client reste a controler par celui-ci (RecordMove puis SameEvents)
+template <class B>
+bool DecodeEventsFrame(const NetMessage& m, MoveEventStream<B>& out) {
+    if (m.type != MSG_EVENTS || m.size % sizeof(MoveEvent) != 0) return false;
+    int count = m.size / (int)sizeof(MoveEvent);
+    if (count < 1 || count > MoveEventStream<B>::CAPACITY) return false;
+    std::memcpy(out.events, m.payload, m.size);
+    out.count = count;
+    for (int i = 0; i < count; i++) {
+        if (!IsValidEvent<B>(out.events[i])) return false;
+    }
+    return out.events[0].type == EV_PICKUP;
+}
+
+#endif
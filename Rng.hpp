@@ -0,0 +1,42 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstdint>
+
+// Petit generateur rapide (xorshift64*) : un flux independant par thread,
+// derive d'une graine commune et de l'index du thread via SplitMix64.
+class Rng {
+public:
+    uint64_t state;
+
+    explicit Rng(uint64_t seed = 1, uint64_t stream = 0) {
+        state = SplitMix(seed + stream * 0x9E3779B97F4A7C15ULL);
+        if (state == 0) state = 1;
+    }
+
+    uint64_t Next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    // Entier uniforme dans [0, n)
+    int Below(int n) {
+        return (int)(((Next() >> 32) * (uint64_t)n) >> 32);
+    }
+
+    // Reel uniforme dans [0, 1)
+    double Uniform() {
+        return (Next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    static constexpr uint64_t SplitMix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+};
+
+#endif
@@ -0,0 +1,444 @@
+#ifndef SEARCH_HPP
+#define SEARCH_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Board.hpp"
+#include "BoardSimd.hpp"
+#include "EndgameDb.hpp"
+#include "NeuralEval.hpp"
+#include "TranspositionTable.hpp"
+#include "Zobrist.hpp"
+
+// Recherche negamax alpha-beta sur le plateau compact.
+// Score toujours du point de vue du joueur au trait.
+// Rejouer (ou finir la partie sur son coup) garde le meme joueur au trait :
+// le score de l'enfant est alors pris tel quel, sans changement de signe.
+
+const int SCORE_INF = 1000000;
+const int SCORE_WIN = 100000;
+const int MAX_PLY = 64;         // Profondeur max de l'approfondissement iteratif
+
+// Plus de la moitie des graines dans un magasin : le resultat ne peut plus changer
+template <class B>
+inline bool IsDecided(const B& b) {
+    return IsTerminal(b) || 2 * b.seeds[B::STORE_P1] > B::TOTAL_SEEDS || 2 * b.seeds[B::STORE_P2] > B::TOTAL_SEEDS;
+}
+
+// Score d'un ecart final connu (partie finie ou base de finales)
+inline int ExactScore(int margin) {
+    if (margin > 0) return SCORE_WIN + margin;
+    if (margin < 0) return -SCORE_WIN + margin;
+    return 0;
+}
+
+// Issue decidee sans partie finie : le magasin du gagnant ne peut plus que grossir,
+// son ecart final vaut au moins 2 * magasin - total. Partie finie : ecart exact.
+template <class B>
+inline int DecidedScore(const B& b) {
+    B end = b;
+    if (IsTerminal(b)) SweepRemaining(end);
+    int mine = end.seeds[B::StoreOf(b.sideToMove)];
+    int theirs = end.seeds[B::StoreOf(1 - b.sideToMove)];
+    if (mine > theirs) return SCORE_WIN + 2 * mine - B::TOTAL_SEEDS;
+    if (theirs > mine) return -SCORE_WIN - (2 * theirs - B::TOTAL_SEEDS);
+    return 0;
+}
+
+// Score lisible. Une issue prouvee donne l'ecart final garanti au gagnant : une
+// borne (la recherche s'arrete des que l'issue est sure), sauf si 'exact'.
+inline std::string FormatScore(int score, bool exact = false) {
+    if (score >= SCORE_WIN) return (exact ? "gagne +" : "gagne d'au moins ") + std::to_string(score - SCORE_WIN);
+    if (score <= -SCORE_WIN) return (exact ? "perdu -" : "perdu d'au moins ") + std::to_string(-score - SCORE_WIN);
+    return (score > 0 ? "+" : "") + std::to_string(score);
+}
+
+// Poids de l'evaluation des positions non decidees, en quarts de graine par
+// indicateur (BoardFeatures). Par defaut : la difference de magasins seule.
+struct EvalWeights {
+    int store = 4;      // Par graine d'avance au magasin
+    int ownSeeds = 0;   // Par graine en jeu dans son camp
+    int otherSeeds = 0; // Par graine en jeu dans le camp adverse
+    int captures = 0;   // Par menace de capture (voir BoardFeatures::captures)
+};
+
+// Evaluation : difference de magasins (partie jouee ou decidee => victoire/defaite franche, voir DecidedScore).
+// Avec une base de finales, les positions a peu de graines sont exactes.
+// 'weights' (optionnel) remplace la difference de magasins hors positions decidees.
+template <class B>
+inline int Evaluate(const B& b, const EndgameTable* egtb = nullptr, const EvalWeights* weights = nullptr) {
+    int me = b.sideToMove;
+    int diff = b.seeds[B::StoreOf(me)] - b.seeds[B::StoreOf(1 - me)];
+    int margin;
+    if (egtb && !IsTerminal(b) && ProbeFinalMargin(*egtb, b, margin)) return ExactScore(margin);
+    if (IsDecided(b)) return DecidedScore(b);
+    if (weights) {
+        BoardFeatures f = ComputeFeatures(b);
+        return (weights->store * f.storeDiff + weights->ownSeeds * f.ownSeeds + weights->otherSeeds * f.otherSeeds
+                + weights->captures * f.captures) / 4;
+    }
+    return diff;
+}
+
+struct SearchResult {
+    int bestMove = -1;
+    int score = 0;
+    int depth = 0;              // Derniere iteration terminee
+    uint64_t nodes = 0;
+    double seconds = 0.0;
+    int pv[MAX_PLY];            // Variante principale (coups successifs, rejoues compris)
+    int pvLength = 0;
+    bool exact = false;         // Issue prouvee avec son ecart final exact (racine dans la base de finales)
+};
+
+// Pilotage d'une recherche depuis un autre thread (voir AIWorker.hpp)
+struct SearchSignals {
+    typedef std::chrono::steady_clock Clock;
+
+    std::atomic<bool> stop{false};      // Annulation immediate
+    std::atomic<int64_t> deadline{0};   // Echeance en ticks de Clock (0 = aucune), modifiable en cours de route
+    std::function<void(const SearchResult&)> onIteration; // Appelee (thread de recherche) a chaque iteration terminee
+
+    void SetDeadline(Clock::time_point t) {
+        deadline.store((int64_t)t.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    bool GetDeadline(Clock::time_point& out) const {
+        int64_t ticks = deadline.load(std::memory_order_relaxed);
+        if (ticks == 0) return false;
+        out = Clock::time_point(Clock::duration(ticks));
+        return true;
+    }
+};
+
+struct SearchLimits {
+    int maxDepth = MAX_PLY;
+    int timeLimitMs = 0;        // Limite dure par coup (0 = aucune)
+    int threads = 1;            // > 1 : threads auxiliaires partageant la table de transposition
+    bool ponder = false;        // Reflexion sur le temps adverse : pas d'echeance tant que signals n'en pose pas
+    SearchSignals* signals = nullptr; // Optionnel : arret, echeance et suivi depuis un autre thread
+    const EvalWeights* weights = nullptr; // Optionnel : evaluation ponderee (tournois de reglages)
+    const NeuralNet* net = nullptr;       // Optionnel : evaluation par le reseau (NeuralEval.hpp)
+};
+
+// Etat partage par tous les noeuds d'une recherche
+struct SearchContext {
+    typedef std::chrono::steady_clock Clock;
+
+    uint64_t nodes = 0;
+    uint64_t nextCheck = 1024;
+    bool hasDeadline = false;
+    bool stopped = false;
+    Clock::time_point deadline;
+    TranspositionTable* tt = nullptr;        // Optionnelle
+    const EndgameTable* egtb = nullptr;      // Optionnelle
+    std::atomic<bool>* sharedStop = nullptr; // Arret commun aux threads d'une meme recherche
+    SearchSignals* signals = nullptr;        // Arret et echeance venus de l'exterieur
+    const EvalWeights* weights = nullptr;    // Optionnels
+    const NeuralNet* net = nullptr;
+    int killer[MAX_PLY + 1];                // Coup qui a coupe a ce ply (amorce par la PV precedente)
+    int pvTable[MAX_PLY + 1][MAX_PLY + 1];  // PV triangulaire
+    int pvLength[MAX_PLY + 1];
+
+    // Reseau : chemin courant et accumulateurs par ply (les feuilles evaluees
+    // sur place sont a ply + 1, d'ou une case de plus)
+    const void* nodeBoard[MAX_PLY + 2];     // Position du chemin courant a ce ply (B, voir AlphaBeta)
+    uint64_t nodeHash[MAX_PLY + 2];
+    uint64_t accKey[MAX_PLY + 2];           // Position dont acc[ply] est l'accumulateur (0 = aucune)
+    NnAccumulator acc[MAX_PLY + 2];
+
+    SearchContext() {
+        for (int i = 0; i <= MAX_PLY; i++) { killer[i] = -1; pvLength[i] = 0; }
+        for (int i = 0; i <= MAX_PLY + 1; i++) { nodeBoard[i] = nullptr; accKey[i] = 0; }
+    }
+
+    // L'horloge n'est lue que tous les ~1024 noeuds
+    bool CountNode() {
+        if (++nodes >= nextCheck) {
+            nextCheck = nodes + 1024;
+            if (hasDeadline && Clock::now() >= deadline) stopped = true;
+            if (sharedStop && sharedStop->load(std::memory_order_relaxed)) stopped = true;
+            if (signals) {
+                Clock::time_point t;
+                if (signals->stop.load(std::memory_order_relaxed) || (signals->GetDeadline(t) && Clock::now() >= t)) stopped = true;
+            }
+        }
+        return stopped;
+    }
+
+    // Echeance en vigueur (la sienne, ou celle posee de l'exterieur apres coup)
+    bool GetDeadline(Clock::time_point& out) const {
+        if (signals && signals->GetDeadline(out)) return true;
+        out = deadline;
+        return hasDeadline;
+    }
+};
+
+// Joue tous les coups legaux et les trie : coup de la table de transposition,
+// puis coup "killer", puis ceux qui font rejouer, puis les captures, puis le
+// gain de magasin. Le hash de chaque enfant est mis a jour au passage.
+// Renvoie le nombre de coups.
+template <class B>
+int GenerateOrderedChildren(const B& b, uint64_t hash, int ttMove, int killerMove,
+                            B children[], uint64_t hashes[], int moves[]) {
+    typename B::MoveList list = LegalMoves(b);
+    int keys[B::PITS_PER_SIDE];
+    int me = b.sideToMove;
+
+    for (int i = 0; i < list.count; i++) {
+        B child = b;
+        MoveResult r = ApplyMove(child, list.moves[i]);
+        uint64_t childHash = UpdateHash(hash, b, child);
+        int key = child.seeds[B::StoreOf(me)] - b.seeds[B::StoreOf(me)];
+        if (r.captured > 0) key += 1000;
+        if (r.extraTurn) key += 2000;
+        if (list.moves[i] == killerMove) key += 10000;
+        if (list.moves[i] == ttMove) key += 20000;
+
+        // Tri par insertion (au plus PITS_PER_SIDE coups)
+        int j = i;
+        while (j > 0 && keys[j - 1] < key) {
+            keys[j] = keys[j - 1]; moves[j] = moves[j - 1]; children[j] = children[j - 1]; hashes[j] = hashes[j - 1];
+            j--;
+        }
+        keys[j] = key; moves[j] = list.moves[i]; children[j] = child; hashes[j] = childHash;
+    }
+    return list.count;
+}
+
+// Accumulateur du reseau pour la position 'b' a ce ply : deja la (meme
+// position), sinon deduit de celui du parent, ou du grand-parent si le parent
+// n'en a pas (calcule a son tour au besoin), sinon recalcule. Sauter le parent
+// evite de calculer un accumulateur qui ne servirait le plus souvent qu'a une
+// seule feuille (les coupures arretent vite ses freres) ; la mise a jour sur
+// deux coups coute a peine plus que sur un.
+template <class B>
+void EnsureAccumulator(const B& b, uint64_t hash, int ply, SearchContext& ctx) {
+    if (ctx.accKey[ply] == hash) return;
+    int from = ply - 1;
+    if (from > 0 && ctx.accKey[from] != ctx.nodeHash[from]) from--;
+    const B* base = from >= 0 ? static_cast<const B*>(ctx.nodeBoard[from]) : nullptr;
+    if (base) {
+        EnsureAccumulator(*base, ctx.nodeHash[from], from, ctx);
+        ctx.net->Update(ctx.acc[from], *base, b, ctx.acc[ply]);
+    } else {
+        ctx.net->Refresh(b, ctx.acc[ply]);
+    }
+    ctx.accKey[ply] = hash;
+}
+
+// Evaluation d'une feuille. Avec le reseau, sa correction etant bornee (bornes
+// propres au reseau charge, voir MinCorrection), une feuille que la difference
+// de magasins place deja hors de ]alpha, beta[ n'est pas passee au reseau : la
+// borne renvoyee suffit a l'alpha-beta. Les feuilles decidees (partie jouee,
+// base de finales) ne demandent jamais d'accumulateur.
+template <class B>
+inline int EvaluateLeaf(const B& b, uint64_t hash, int ply, int alpha, int beta, SearchContext& ctx) {
+    if (!ctx.net) return Evaluate(b, ctx.egtb, ctx.weights);
+    int margin;
+    if (ctx.egtb && !IsTerminal(b) && ProbeFinalMargin(*ctx.egtb, b, margin)) return ExactScore(margin);
+    if (IsDecided(b)) return Evaluate(b);
+    int diff = b.seeds[B::StoreOf(b.sideToMove)] - b.seeds[B::StoreOf(1 - b.sideToMove)];
+    if (diff + ctx.net->MaxCorrection() <= alpha) return diff + ctx.net->MaxCorrection();
+    if (diff + ctx.net->MinCorrection() >= beta) return diff + ctx.net->MinCorrection();
+    EnsureAccumulator(b, hash, ply, ctx);
+    return ctx.net->Evaluate(b, ctx.acc[ply]);
+}
+
+template <class B>
+int AlphaBeta(const B& b, uint64_t hash, int depth, int ply, int alpha, int beta, SearchContext& ctx) {
+    ctx.pvLength[ply] = 0;
+    if (ctx.CountNode()) return 0;
+    if (ctx.net) { ctx.nodeBoard[ply] = &b; ctx.nodeHash[ply] = hash; }
+    if (depth <= 0 || ply >= MAX_PLY || IsDecided(b)) return EvaluateLeaf(b, hash, ply, alpha, beta, ctx);
+
+    // Finale connue : lecture directe (a la racine il faut quand meme choisir un coup)
+    int margin;
+    if (ply > 0 && ctx.egtb && ProbeFinalMargin(*ctx.egtb, b, margin)) return ExactScore(margin);
+
+    // Les scores ne dependent que de la position : pas d'ajustement selon le ply
+    int ttMove = -1;
+    if (ctx.tt) {
+        TTEntry e;
+        if (ctx.tt->Probe(hash, e)) {
+            ttMove = e.bestMove;
+            if (ply > 0 && e.depth >= depth) {
+                if (e.bound == BOUND_EXACT) return e.score;
+                if (e.bound == BOUND_LOWER && e.score >= beta) return e.score;
+                if (e.bound == BOUND_UPPER && e.score <= alpha) return e.score;
+            }
+        }
+    }
+
+    B children[B::PITS_PER_SIDE];
+    uint64_t hashes[B::PITS_PER_SIDE];
+    int moves[B::PITS_PER_SIDE];
+    int count = GenerateOrderedChildren(b, hash, ttMove, ctx.killer[ply], children, hashes, moves);
+
+    int alphaOrig = alpha;
+    int best = -SCORE_INF;
+    int bestMove = -1;
+    for (int i = 0; i < count; i++) {
+        const B& child = children[i];
+        bool sameSide = child.sideToMove == b.sideToMove;
+        int score;
+        if (depth == 1) {
+            // Les enfants sont deja joues : feuilles evaluees sur place, sans appel recursif
+            ctx.nodes++;
+            ctx.pvLength[ply + 1] = 0;
+            score = sameSide ? EvaluateLeaf(child, hashes[i], ply + 1, alpha, beta, ctx)
+                             : -EvaluateLeaf(child, hashes[i], ply + 1, -beta, -alpha, ctx);
+        } else {
+            score = sameSide ? AlphaBeta(child, hashes[i], depth - 1, ply + 1, alpha, beta, ctx)
+                             : -AlphaBeta(child, hashes[i], depth - 1, ply + 1, -beta, -alpha, ctx);
+            if (ctx.stopped) return 0;
+        }
+
+        if (score > best) {
+            best = score;
+            bestMove = moves[i];
+            if (score > alpha) {
+                alpha = score;
+                // PV de ce noeud = ce coup + PV de l'enfant
+                ctx.pvTable[ply][0] = moves[i];
+                for (int k = 0; k < ctx.pvLength[ply + 1]; k++) ctx.pvTable[ply][k + 1] = ctx.pvTable[ply + 1][k];
+                ctx.pvLength[ply] = ctx.pvLength[ply + 1] + 1;
+            }
+        }
+        if (alpha >= beta) {
+            ctx.killer[ply] = moves[i];
+            break;
+        }
+    }
+
+    if (ctx.tt) {
+        BoundType bound = best >= beta ? BOUND_LOWER : (best > alphaOrig ? BOUND_EXACT : BOUND_UPPER);
+        ctx.tt->Store(hash, best, depth, bestMove, bound);
+    }
+    return best;
+}
+
+// Thread auxiliaire (Lazy SMP) : approfondit en boucle pour remplir la table
+// partagee, en decalant sa profondeur pour ne pas suivre exactement le thread principal.
+template <class B>
+void SearchHelper(const B& b, int maxDepth, int firstDepth, SearchContext& ctx) {
+    uint64_t hash = HashPosition(b);
+    for (int depth = firstDepth; depth <= maxDepth && !ctx.stopped; depth++) {
+        AlphaBeta(b, hash, depth, 0, -SCORE_INF, SCORE_INF, ctx);
+    }
+}
+
+// Approfondissement iteratif : profondeur 1, 2, 3... jusqu'a maxDepth ou la limite de temps.
+// Une iteration interrompue est ignoree, on garde le resultat de la precedente.
+// Avec une table de transposition, limits.threads > 1 lance des threads auxiliaires
+// qui la partagent sans verrou ; seul le thread appelant produit le resultat.
+// Avec limits.signals, la recherche peut etre arretee ou recevoir son echeance
+// depuis un autre thread (limits.ponder : aucune echeance au depart).
+template <class B>
+SearchResult SearchPosition(const B& b, const SearchLimits& limits, TranspositionTable* tt = nullptr,
+                            const EndgameTable* egtb = nullptr) {
+    SearchResult result;
+    SearchContext ctx;
+    SearchContext::Clock::time_point start = SearchContext::Clock::now();
+    if (limits.timeLimitMs > 0 && !limits.ponder) {
+        ctx.hasDeadline = true;
+        ctx.deadline = start + std::chrono::milliseconds(limits.timeLimitMs);
+    }
+    ctx.signals = limits.signals;
+    ctx.tt = tt;
+    ctx.egtb = egtb;
+    ctx.weights = limits.weights;
+    ctx.net = limits.net;
+    if (tt) tt->NewSearch();
+
+    typename B::MoveList moves = LegalMoves(b);
+    if (moves.count == 0) return result;
+    result.bestMove = moves.moves[0];
+    if (moves.count == 1) { // Coup force : inutile de chercher
+        result.pv[0] = result.bestMove;
+        result.pvLength = 1;
+        return result;
+    }
+
+    int maxDepth = limits.maxDepth < MAX_PLY ? limits.maxDepth : MAX_PLY;
+
+    // Racine dans la base : tous les enfants y sont aussi, une iteration suffit
+    int rootMargin;
+    if (egtb && ProbeFinalMargin(*egtb, b, rootMargin)) {
+        maxDepth = 1;
+        result.exact = true;
+    }
+
+    std::atomic<bool> stopHelpers(false);
+    int helperCount = (tt && limits.threads > 1) ? limits.threads - 1 : 0;
+    std::vector<SearchContext> helperCtx(helperCount);
+    std::vector<std::thread> helpers;
+    for (int t = 0; t < helperCount; t++) {
+        SearchContext& hc = helperCtx[t];
+        hc.hasDeadline = ctx.hasDeadline;
+        hc.deadline = ctx.deadline;
+        hc.tt = tt;
+        hc.egtb = egtb;
+        hc.weights = limits.weights;
+        hc.net = limits.net;
+        hc.sharedStop = &stopHelpers;
+        helpers.emplace_back([&b, &hc, maxDepth, t]() { SearchHelper(b, maxDepth, 1 + (t & 1), hc); });
+    }
+
+    uint64_t hash = HashPosition(b);
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        int score = AlphaBeta(b, hash, depth, 0, -SCORE_INF, SCORE_INF, ctx);
+        if (ctx.stopped) break;
+
+        result.depth = depth;
+        result.score = score;
+        result.pvLength = ctx.pvLength[0];
+        for (int k = 0; k < result.pvLength; k++) result.pv[k] = ctx.pvTable[0][k];
+        if (result.pvLength > 0) result.bestMove = result.pv[0];
+
+        // La PV amorce l'ordre des coups de l'iteration suivante
+        for (int k = 0; k < result.pvLength; k++) ctx.killer[k] = result.pv[k];
+
+        if (limits.signals && limits.signals->onIteration) {
+            result.nodes = ctx.nodes;
+            result.seconds = std::chrono::duration<double>(SearchContext::Clock::now() - start).count();
+            limits.signals->onIteration(result);
+        }
+
+        // Resultat prouve : aller plus loin ne changerait que l'ecart garanti (voir DecidedScore)
+        if (score >= SCORE_WIN || score <= -SCORE_WIN) break;
+        SearchContext::Clock::time_point deadline;
+        if (ctx.GetDeadline(deadline)) {
+            // L'iteration suivante coute plusieurs fois celle-ci : inutile de la commencer si elle ne peut finir
+            // (moins de la moitie du budget restant)
+            double remaining = std::chrono::duration<double, std::milli>(deadline - SearchContext::Clock::now()).count();
+            if (remaining * 2.0 < limits.timeLimitMs) break;
+        }
+    }
+
+    stopHelpers.store(true, std::memory_order_relaxed);
+    for (auto& h : helpers) h.join();
+
+    result.nodes = ctx.nodes;
+    for (const auto& hc : helperCtx) result.nodes += hc.nodes;
+    result.seconds = std::chrono::duration<double>(SearchContext::Clock::now() - start).count();
+    return result;
+}
+
+// Meilleur coup a profondeur fixe (-1 si aucun coup)
+template <class B>
+int SearchBestMove(const B& b, int depth, int* bestScore = nullptr) {
+    SearchLimits limits;
+    limits.maxDepth = depth;
+    SearchResult r = SearchPosition(b, limits);
+    if (bestScore) *bestScore = r.score;
+    return r.bestMove;
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef SELFPLAY_HPP
+#define SELFPLAY_HPP
+
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <memory>
+
+#include "Board.hpp"
+#include "BoardSimd.hpp"
+#include "GameRecord.hpp"
+#include "Policies.hpp"
+
+// Auto-jeu sans fenetre : N parties reparties sur tous les coeurs
+
+struct SelfPlayConfig {
+    long games = 10000;
+    int threads = 0;          // 0 = tous les coeurs
+    PolicyConfig players[2];  // Politique du J1 (Bas) et du J2 (Haut)
+    uint64_t seed = 1;
+    int maxPlies = 1000;      // Garde-fou : l'Oware peut boucler, la partie est alors arretee et ramassee
+    int hashMb = 4;           // Table de transposition par thread pour les politiques de recherche
+    GameRecordWriter* record = nullptr; // Archive des parties (facultative)
+};
+
+struct SelfPlayStats {
+    long games = 0;
+    long plies = 0;
+    long wins[2] = {0, 0};
+    long draws = 0;
+    long truncated = 0;       // Parties arretees par maxPlies
+    double seconds = 0.0;
+
+    void Merge(const SelfPlayStats& o) {
+        games += o.games; plies += o.plies;
+        wins[0] += o.wins[0]; wins[1] += o.wins[1];
+        draws += o.draws; truncated += o.truncated;
+    }
+};
+
+inline int DefaultThreadCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? (int)n : 1;
+}
+
+// Joueur d'une politique, pour l'en-tete d'une partie archivee
+inline void DescribeRecordPlayer(GameRecordHeader& h, int player, const PolicyConfig& p) {
+    static const RecordPlayer KINDS[] = {PLAYER_RANDOM, PLAYER_GREEDY, PLAYER_ALPHABETA, PLAYER_MCTS};
+    h.players[player] = KINDS[p.kind];
+    h.levels[player] = p.kind == POLICY_SEARCH ? p.depth : p.kind == POLICY_MCTS ? (uint32_t)p.iterations : 0;
+    if ((p.kind == POLICY_SEARCH || p.kind == POLICY_MCTS) && p.timeMs > 0) {
+        h.levels[player] = p.timeMs;
+        h.flags |= player == 0 ? RECORD_P1_TIMED : RECORD_P2_TIMED;
+    }
+}
+
+// Joue une partie complete depuis la position de depart, renvoie le vainqueur (-1 = egalite).
+// 'record' (optionnel) : la partie y est ajoutee, encodee pour GameRecordWriter.
+template <class B>
+int PlaySelfPlayGame(const PolicyConfig players[2], Rng& rng, int maxPlies, SelfPlayStats& stats,
+                     TranspositionTable* tt = nullptr, MctsArena* arena = nullptr, std::vector<uint8_t>* record = nullptr) {
+    B b = B::Initial();
+    int plies = 0;
+    bool truncated = false;
+    uint8_t moves[RECORD_MAX_MOVES];
+    while (!IsTerminal(b)) {
+        if (plies >= maxPlies || plies >= RECORD_MAX_MOVES) {
+            SweepRemaining(b);
+            stats.truncated++;
+            truncated = true;
+            break;
+        }
+        int move = ChooseMove(b, players[b.sideToMove], rng, tt, arena);
+        ApplyMove(b, move);
+        moves[plies++] = (uint8_t)move;
+    }
+    if (record) {
+        GameRecordHeader h = MakeGameRecordHeader(b, plies, true);
+        if (truncated) h.flags |= RECORD_TRUNCATED;
+        DescribeRecordPlayer(h, 0, players[0]);
+        DescribeRecordPlayer(h, 1, players[1]);
+        EncodeGame(*record, h, moves);
+    }
+    int w = Winner(b);
+    stats.games++;
+    stats.plies += plies;
+    if (w < 0) stats.draws++; else stats.wins[w]++;
+    return w;
+}
+
+// Aleatoire contre aleatoire : les parties sont jouees de front, par lots vectoriels
+template <class B>
+void PlayRandomGamesBatched(long games, Rng& rng, int maxPlies, SelfPlayStats& stats) {
+    PlayoutOutcome outcomes[PLAYOUT_BATCH];
+    for (long done = 0; done < games; done += PLAYOUT_BATCH) {
+        int count = games - done < PLAYOUT_BATCH ? (int)(games - done) : PLAYOUT_BATCH;
+        BatchPlayouts(B::Initial(), count, rng, maxPlies, outcomes);
+        for (int i = 0; i < count; i++) {
+            stats.games++;
+            stats.plies += outcomes[i].plies;
+            if (outcomes[i].truncated) stats.truncated++;
+            if (outcomes[i].winner < 0) stats.draws++; else stats.wins[outcomes[i].winner]++;
+        }
+    }
+}
+
+template <class B>
+SelfPlayStats RunSelfPlay(const SelfPlayConfig& cfg) {
+    int threadCount = cfg.threads > 0 ? cfg.threads : DefaultThreadCount();
+    std::vector<SelfPlayStats> perThread(threadCount);
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&cfg, &perThread, t, threadCount]() {
+            Rng rng(cfg.seed, t); // Flux propre a chaque thread
+            SelfPlayStats local;  // Pas de partage de ligne de cache pendant la boucle
+            bool searching = cfg.players[0].kind == POLICY_SEARCH || cfg.players[1].kind == POLICY_SEARCH;
+            std::unique_ptr<TranspositionTable> tt(searching ? new TranspositionTable(cfg.hashMb) : nullptr);
+            bool mcts = cfg.players[0].kind == POLICY_MCTS || cfg.players[1].kind == POLICY_MCTS;
+            std::unique_ptr<MctsArena> arena(mcts ? new MctsArena(1 << 20) : nullptr); // Reutilisee a chaque coup
+            long first = cfg.games * t / threadCount;
+            long last = cfg.games * (t + 1) / threadCount;
+            // Les lots vectoriels ne gardent pas les coups : pas d'archive possible par ce chemin
+            if (cfg.players[0].kind == POLICY_RANDOM && cfg.players[1].kind == POLICY_RANDOM && !cfg.record) {
+                PlayRandomGamesBatched<B>(last - first, rng, cfg.maxPlies, local);
+                first = last;
+            }
+            std::vector<uint8_t> record; // Parties encodees, ecrites par blocs d'environ 1 Mo
+            for (long g = first; g < last; g++) {
+                PlaySelfPlayGame<B>(cfg.players, rng, cfg.maxPlies, local, tt.get(), arena.get(), cfg.record ? &record : nullptr);
+                if (record.size() >= (1u << 20)) { cfg.record->WriteEncoded(record); record.clear(); }
+            }
+            if (!record.empty()) cfg.record->WriteEncoded(record);
+            perThread[t] = local;
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    SelfPlayStats total;
+    for (const auto& s : perThread) total.Merge(s);
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
+
+#endif
@@ -9,6 +9,49 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <unordered_map>
+
+// Emplacement d'un uniforme, obtenu une fois (Shader::getUniform) et type :
+// un Uniform<glm::mat4> ne peut recevoir qu'une matrice
+template <class T>
+struct Uniform {
+    int location = -1; // -1 : inconnu, les glUniform* l'ignorent
+};
+
+// --- DONNEES DE L'IMAGE (bloc "FrameData", std140) ---
+// Identiques pour tous les objets d'une image : ecrites une fois par image dans
+// un tampon d'uniformes lie au point FRAME_UNIFORM_BINDING, que chaque programme
+// qui declare le bloc lit directement.
+const unsigned int FRAME_UNIFORM_BINDING = 0;
+
+struct FrameUniforms {
+    glm::mat4 projection;
+    glm::mat4 view;
+    glm::vec3 viewPos;
+    float padding0;          // std140 : un vec3 occupe 16 octets...
+    glm::vec3 lightPos;
+    float padding1;
+    glm::vec3 lightColor;
+    float ambientStrength;   // ...sauf si un float le complete
+};
+static_assert(sizeof(FrameUniforms) == 176, "Disposition std140 du bloc FrameData");
+
+class FrameUniformBuffer {
+public:
+    unsigned int ID = 0;
+
+    void create() {
+        glGenBuffers(1, &ID);
+        glBindBuffer(GL_UNIFORM_BUFFER, ID);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), NULL, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BINDING, ID);
+    }
+
+    void update(const FrameUniforms& frame) {
+        glBindBuffer(GL_UNIFORM_BUFFER, ID);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+    }
+};
 
 class Shader {
 public:
@@ -65,35 +108,97 @@ public:
 
         glDeleteShader(vertex);
         glDeleteShader(fragment);
+
+        // 3. Uniformes actifs, releves une fois pour toutes ; bloc de l'image sur son point de liaison
+        reflectUniforms();
+        unsigned int frameBlock = glGetUniformBlockIndex(ID, "FrameData");
+        if (frameBlock != GL_INVALID_INDEX) glUniformBlockBinding(ID, frameBlock, FRAME_UNIFORM_BINDING);
     }
 
     void use() {
         glUseProgram(ID);
     }
 
-    // Fonctions utilitaires pour les uniformes
+    // Poignee typee d'un uniforme (a garder : la recherche par nom ne se fait qu'ici)
+    template <class T>
+    Uniform<T> getUniform(const std::string &name) const {
+        Uniform<T> u;
+        auto it = uniforms.find(name);
+        if (it == uniforms.end()) {
+            std::cout << "ERREUR::SHADER::UNIFORME_INCONNU: " << name << std::endl;
+            return u;
+        }
+        if (!acceptsType(it->second.type, (T*)nullptr)) {
+            std::cout << "ERREUR::SHADER::UNIFORME_MAL_TYPE: " << name << std::endl;
+            return u;
+        }
+        u.location = it->second.location;
+        return u;
+    }
+
+    void set(Uniform<bool> u, bool value) const { glUniform1i(u.location, (int)value); }
+    void set(Uniform<int> u, int value) const { glUniform1i(u.location, value); }
+    void set(Uniform<float> u, float value) const { glUniform1f(u.location, value); }
+    void set(Uniform<glm::vec3> u, const glm::vec3 &value) const { glUniform3fv(u.location, 1, &value[0]); }
+    void set(Uniform<glm::mat4> u, const glm::mat4 &mat) const { glUniformMatrix4fv(u.location, 1, GL_FALSE, &mat[0][0]); }
+
+    // Fonctions utilitaires pour les uniformes (par nom : emplacement lu dans la table relevee au chargement)
     void setBool(const std::string &name, bool value) const {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+        glUniform1i(location(name), (int)value);
     }
     void setInt(const std::string &name, int value) const {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+        glUniform1i(location(name), value);
     }
     void setFloat(const std::string &name, float value) const {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+        glUniform1f(location(name), value);
     }
 
     void setVec3(const std::string &name, const glm::vec3 &value) const {
-        glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+        glUniform3fv(location(name), 1, &value[0]);
     }
     void setVec3(const std::string &name, float x, float y, float z) const {
-        glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+        glUniform3f(location(name), x, y, z);
     }
 
     void setMat4(const std::string &name, const glm::mat4 &mat) const {
-        glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+        glUniformMatrix4fv(location(name), 1, GL_FALSE, &mat[0][0]);
     }
 
 private:
+    struct UniformInfo {
+        int location;
+        GLenum type;
+    };
+    std::unordered_map<std::string, UniformInfo> uniforms; // Uniformes actifs hors blocs
+
+    void reflectUniforms() {
+        int count = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+        for (int i = 0; i < count; i++) {
+            char name[256];
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(ID, (GLuint)i, sizeof(name), &length, &size, &type, name);
+            int loc = glGetUniformLocation(ID, name);
+            if (loc < 0) continue; // Membre d'un bloc (FrameData) : pas d'emplacement propre
+            std::string key(name, length);
+            if (key.size() > 3 && key.compare(key.size() - 3, 3, "[0]") == 0) key.resize(key.size() - 3); // Tableaux
+            uniforms[key] = {loc, type};
+        }
+    }
+
+    int location(const std::string &name) const {
+        auto it = uniforms.find(name);
+        return it == uniforms.end() ? -1 : it->second.location;
+    }
+
+    static bool acceptsType(GLenum type, bool*) { return type == GL_BOOL; }
+    static bool acceptsType(GLenum type, int*) { return type == GL_INT || type == GL_SAMPLER_2D; }
+    static bool acceptsType(GLenum type, float*) { return type == GL_FLOAT; }
+    static bool acceptsType(GLenum type, glm::vec3*) { return type == GL_FLOAT_VEC3; }
+    static bool acceptsType(GLenum type, glm::mat4*) { return type == GL_FLOAT_MAT4; }
+
     void checkCompileErrors(unsigned int shader, std::string type) {
         int success;
         char infoLog[1024];
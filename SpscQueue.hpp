@@ -0,0 +1,40 @@
+#ifndef SPSCQUEUE_HPP
+#define SPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+
+// File circulaire sans verrou, un seul producteur et un seul consommateur.
+// Chaque indice n'est ecrit que par un cote : le producteur publie une case
+// avec un store "release" sur 'tail', le consommateur la libere de meme sur 'head'.
+// CAPACITY est une puissance de deux (masque au lieu d'un modulo).
+template <class T, size_t CAPACITY>
+class SpscQueue {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY doit etre une puissance de deux");
+
+public:
+    // Producteur seulement. false si la file est pleine.
+    bool Push(const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == CAPACITY) return false;
+        slots[t & (CAPACITY - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consommateur seulement. false si la file est vide.
+    bool Pop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        out = slots[h & (CAPACITY - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T slots[CAPACITY];
+    alignas(64) std::atomic<size_t> head{0}; // Lignes de cache distinctes : pas de faux partage
+    alignas(64) std::atomic<size_t> tail{0};
+};
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef TOURNAMENT_HPP
+#define TOURNAMENT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "Board.hpp"
+#include "Mcts.hpp"
+#include "Policies.hpp"
+#include "Rng.hpp"
+#include "Search.hpp"
+#include "TranspositionTable.hpp"
+#include "Zobrist.hpp"
+
+// Tournoi entre reglages de l'ordinateur : toutes rondes (chacun contre chacun)
+// ou gauntlet (le premier contre tous les autres). Chaque ouverture est jouee
+// deux fois par paire, chaque moteur a son tour en J1 : l'avantage du trait
+// et celui de l'ouverture s'annulent. Les parties sont reparties sur tous les coeurs.
+
+enum TournamentMode {
+    TOURNAMENT_ROUND_ROBIN,
+    TOURNAMENT_GAUNTLET
+};
+
+struct TournamentConfig {
+    std::vector<PolicyConfig> engines;
+    TournamentMode mode = TOURNAMENT_ROUND_ROBIN;
+    int openings = 50;         // Ouvertures (chacune jouee deux fois par paire)
+    int openingPlies = 4;      // Demi-coups aleatoires avant la partie
+    int openingDepth = 8;      // Recherche qui juge l'equilibre d'une ouverture
+    int openingMargin = 2;     // Ecart de score toleree (en graines) pour une ouverture equilibree
+    int threads = 0;           // 0 = tous les coeurs
+    int hashMb = 4;            // Table de transposition par moteur et par thread
+    int maxPlies = 1000;       // Garde-fou (Oware qui boucle) : partie arretee et ramassee
+    uint64_t seed = 1;
+};
+
+// Resultats d'une paire, vus du premier moteur
+struct PairResult {
+    int a, b;
+    long wins = 0, draws = 0, losses = 0;
+};
+
+struct EngineResult {
+    long games = 0;
+    double points = 0.0;       // 1 par victoire, 0.5 par nulle
+    double elo = 0.0;          // Classement (moyenne nulle, ou premier moteur a 0 en gauntlet)
+    double eloMargin = 0.0;    // Demi-largeur de l'intervalle de confiance a 95 %
+    uint64_t nodes = 0;        // Noeuds (alpha-beta) ou playouts (MCTS)
+    double seconds = 0.0;      // Temps de reflexion total
+    long moves = 0;
+};
+
+struct TournamentResult {
+    std::vector<EngineResult> engines;
+    std::vector<PairResult> pairs;
+    long games = 0;
+    int openings = 0;          // Ouvertures equilibrees effectivement trouvees
+    double seconds = 0.0;
+};
+
+// --- OUVERTURES EQUILIBREES ---
+// Positions distinctes a 'openingPlies' demi-coups du depart, tirees au hasard,
+// gardees si une recherche les juge a moins de 'openingMargin' graines d'ecart.
+template <class B>
+std::vector<B> GenerateBalancedOpenings(const TournamentConfig& cfg) {
+    std::vector<B> openings;
+    std::unordered_set<uint64_t> seen;
+    Rng rng(cfg.seed, 0x0BE7);
+    TranspositionTable tt(cfg.hashMb);
+    SearchLimits limits;
+    limits.maxDepth = cfg.openingDepth;
+    for (int attempt = 0; attempt < cfg.openings * 50 && (int)openings.size() < cfg.openings; attempt++) {
+        B b = B::Initial();
+        for (int ply = 0; ply < cfg.openingPlies && !IsTerminal(b); ply++) {
+            typename B::MoveList moves = LegalMoves(b);
+            ApplyMove(b, moves.moves[rng.Below(moves.count)]);
+        }
+        if (IsTerminal(b) || !seen.insert(HashPosition(b)).second) continue;
+        int score = SearchPosition(b, limits, &tt).score;
+        if (std::abs(score) <= cfg.openingMargin) openings.push_back(b);
+    }
+    return openings;
+}
+
+// --- ELO ---
+// Ecart Elo correspondant a un score moyen (0 < s < 1)
+inline double EloFromScore(double s) {
+    s = std::min(std::max(s, 1e-3), 1.0 - 1e-3);
+    return -400.0 * std::log10(1.0 / s - 1.0);
+}
+
+// Demi-largeur a 95 % de l'Elo d'un score : ecart type du score sur 'games'
+// parties (victoire / nulle / defaite), propage par la derivee de EloFromScore
+inline double EloMargin(long wins, long draws, long losses) {
+    long n = wins + draws + losses;
+    if (n == 0) return 0.0;
+    double s = (wins + 0.5 * draws) / n;
+    double variance = (wins * (1.0 - s) * (1.0 - s) + draws * (0.5 - s) * (0.5 - s) + losses * s * s) / n;
+    double sc = std::min(std::max(s, 1e-3), 1.0 - 1e-3);
+    double slope = 400.0 / (std::log(10.0) * sc * (1.0 - sc));
+    return 1.96 * std::sqrt(variance / n) * slope;
+}
+
+// Classement de Bradley-Terry (maximum de vraisemblance, nulle = demi-victoire),
+// par l'algorithme MM. Une nulle fictive par paire evite les forces infinies
+// d'un moteur qui gagne tout.
+inline void FitElo(const std::vector<PairResult>& pairs, std::vector<EngineResult>& engines, bool anchorFirst) {
+    int n = (int)engines.size();
+    std::vector<double> gamma(n, 1.0);
+    for (int iter = 0; iter < 10000; iter++) {
+        double change = 0.0;
+        for (int i = 0; i < n; i++) {
+            double won = 0.0, denom = 0.0;
+            for (const PairResult& p : pairs) {
+                if (p.a != i && p.b != i) continue;
+                int j = p.a == i ? p.b : p.a;
+                double games = p.wins + p.draws + p.losses + 1.0;
+                won += (p.a == i ? p.wins : p.losses) + 0.5 * p.draws + 0.5;
+                denom += games / (gamma[i] + gamma[j]);
+            }
+            if (denom <= 0.0) continue;
+            double next = won / denom;
+            change = std::max(change, std::fabs(std::log(next / gamma[i])));
+            gamma[i] = next;
+        }
+        if (change < 1e-9) break;
+    }
+    double offset = 0.0;
+    if (anchorFirst) offset = 400.0 * std::log10(gamma[0]);
+    else {
+        for (int i = 0; i < n; i++) offset += 400.0 * std::log10(gamma[i]) / n;
+    }
+    for (int i = 0; i < n; i++) engines[i].elo = 400.0 * std::log10(gamma[i]) - offset;
+}
+
+// --- PARTIES ---
+struct TournamentGame {
+    int engine[2];  // Moteur en J1, moteur en J2
+    int opening;
+};
+
+// Une partie depuis une ouverture ; renvoie le vainqueur (-1 = egalite)
+template <class B>
+int PlayTournamentGame(const TournamentConfig& cfg, const B& opening, const int engine[2], Rng& rng,
+                       TranspositionTable* tt[2], MctsArena& arena, EngineResult stats[2]) {
+    B b = opening;
+    for (int side = 0; side < 2; side++) {
+        if (tt[side]) tt[side]->Clear(); // Rien d'une partie precedente ou de l'adversaire
+    }
+    int plies = 0;
+    while (!IsTerminal(b)) {
+        if (plies++ >= cfg.maxPlies) {
+            SweepRemaining(b);
+            break;
+        }
+        int side = b.sideToMove;
+        MoveStats work;
+        int move = ChooseMove(b, cfg.engines[engine[side]], rng, tt[side], &arena, &work);
+        stats[side].nodes += work.nodes;
+        stats[side].seconds += work.seconds;
+        stats[side].moves++;
+        ApplyMove(b, move);
+    }
+    return Winner(b);
+}
+
+template <class B>
+TournamentResult RunTournament(const TournamentConfig& cfg) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    TournamentResult result;
+    int n = (int)cfg.engines.size();
+    result.engines.resize(n);
+
+    std::vector<B> openings = GenerateBalancedOpenings<B>(cfg);
+    result.openings = (int)openings.size();
+
+    // Paires, puis chaque ouverture dans les deux sens
+    for (int a = 0; a < n; a++) {
+        for (int b = a + 1; b < n; b++) {
+            if (cfg.mode == TOURNAMENT_GAUNTLET && a != 0) continue;
+            PairResult p;
+            p.a = a;
+            p.b = b;
+            result.pairs.push_back(p);
+        }
+    }
+    std::vector<TournamentGame> games;
+    for (int p = 0; p < (int)result.pairs.size(); p++) {
+        for (int o = 0; o < (int)openings.size(); o++) {
+            for (int swap = 0; swap < 2; swap++) {
+                TournamentGame g;
+                g.engine[0] = swap ? result.pairs[p].b : result.pairs[p].a;
+                g.engine[1] = swap ? result.pairs[p].a : result.pairs[p].b;
+                g.opening = o;
+                games.push_back(g);
+            }
+        }
+    }
+
+    int threadCount = cfg.threads > 0 ? cfg.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<size_t> next(0);
+    std::mutex mutex;
+    std::vector<int> winners(games.size());
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            std::unique_ptr<TranspositionTable> tables[2];
+            for (int side = 0; side < 2; side++) tables[side].reset(new TranspositionTable(cfg.hashMb));
+            TranspositionTable* tt[2] = {tables[0].get(), tables[1].get()};
+            MctsArena arena(1 << 20);
+            std::vector<EngineResult> local(n);
+            for (size_t i = next++; i < games.size(); i = next++) {
+                const TournamentGame& g = games[i];
+                Rng rng(cfg.seed, i + 1); // Meme partie quel que soit le thread qui la joue
+                EngineResult stats[2];
+                winners[i] = PlayTournamentGame(cfg, openings[g.opening], g.engine, rng, tt, arena, stats);
+                for (int side = 0; side < 2; side++) {
+                    EngineResult& e = local[g.engine[side]];
+                    e.nodes += stats[side].nodes;
+                    e.seconds += stats[side].seconds;
+                    e.moves += stats[side].moves;
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int e = 0; e < n; e++) {
+                result.engines[e].nodes += local[e].nodes;
+                result.engines[e].seconds += local[e].seconds;
+                result.engines[e].moves += local[e].moves;
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    // Tableau des resultats (vus du premier moteur de chaque paire)
+    for (size_t i = 0; i < games.size(); i++) {
+        const TournamentGame& g = games[i];
+        PairResult& p = result.pairs[(i / 2) / openings.size()];
+        int w = winners[i];
+        if (w < 0) p.draws++;
+        else if (g.engine[w] == p.a) p.wins++;
+        else p.losses++;
+        for (int side = 0; side < 2; side++) {
+            EngineResult& e = result.engines[g.engine[side]];
+            e.games++;
+            e.points += w < 0 ? 0.5 : (w == side ? 1.0 : 0.0);
+        }
+    }
+    result.games = (long)games.size();
+
+    FitElo(result.pairs, result.engines, cfg.mode == TOURNAMENT_GAUNTLET);
+    for (int e = 0; e < n; e++) {
+        long wins = 0, draws = 0, losses = 0;
+        for (const PairResult& p : result.pairs) {
+            if (p.a == e) { wins += p.wins; draws += p.draws; losses += p.losses; }
+            if (p.b == e) { wins += p.losses; draws += p.draws; losses += p.wins; }
+        }
+        result.engines[e].eloMargin = EloMargin(wins, draws, losses);
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+#endif
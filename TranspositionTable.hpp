@@ -0,0 +1,147 @@
+#ifndef TRANSPOSITIONTABLE_HPP
+#define TRANSPOSITIONTABLE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+// Table de transposition partagee entre threads, sans verrou.
+// Chaque entree tient sur deux mots de 64 bits : (cle ^ donnees, donnees).
+// Une ecriture concurrente peut melanger les deux mots d'une entree : le XOR
+// ne correspond alors plus a la cle et l'entree est simplement ignoree.
+
+enum BoundType : uint8_t {
+    BOUND_NONE  = 0,
+    BOUND_UPPER = 1, // score <= valeur (aucun coup n'a depasse alpha)
+    BOUND_LOWER = 2, // score >= valeur (coupure beta)
+    BOUND_EXACT = 3
+};
+
+struct TTEntry {
+    int score;
+    int depth;
+    int bestMove;    // -1 si inconnu
+    BoundType bound;
+};
+
+class TranspositionTable {
+public:
+    static constexpr int CLUSTER_SIZE = 4; // 4 entrees de 16 octets = une ligne de cache
+
+    explicit TranspositionTable(size_t sizeMb = 16) {
+        Resize(sizeMb);
+    }
+
+    // Taille arrondie a la puissance de deux inferieure (masque au lieu d'un modulo)
+    void Resize(size_t sizeMb) {
+        size_t bytes = (sizeMb > 0 ? sizeMb : 1) * 1024 * 1024;
+        size_t count = 1;
+        while (count * 2 * sizeof(Cluster) <= bytes) count *= 2;
+        clusters.reset(new Cluster[count]);
+        clusterCount = count;
+        Clear();
+    }
+
+    void Clear() {
+        for (size_t i = 0; i < clusterCount; i++) {
+            for (int j = 0; j < CLUSTER_SIZE; j++) {
+                clusters[i].slots[j].check.store(0, std::memory_order_relaxed);
+                clusters[i].slots[j].data.store(0, std::memory_order_relaxed);
+            }
+        }
+        generation.store(0, std::memory_order_relaxed);
+    }
+
+    // A appeler avant chaque nouvelle recherche : les entrees anciennes deviennent remplacables
+    void NewSearch() {
+        generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t SizeBytes() const { return clusterCount * sizeof(Cluster); }
+
+    bool Probe(uint64_t key, TTEntry& out) const {
+        const Cluster& c = clusters[key & (clusterCount - 1)];
+        for (int j = 0; j < CLUSTER_SIZE; j++) {
+            uint64_t data = c.slots[j].data.load(std::memory_order_relaxed);
+            uint64_t check = c.slots[j].check.load(std::memory_order_relaxed);
+            if (data != 0 && (check ^ data) == key) {
+                Unpack(data, out);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Remplacement : meme cle, sinon case vide, sinon la moins utile
+    // (faible profondeur, ou ecrite lors d'une recherche precedente)
+    void Store(uint64_t key, int score, int depth, int bestMove, BoundType bound) {
+        Cluster& c = clusters[key & (clusterCount - 1)];
+        uint8_t gen = generation.load(std::memory_order_relaxed);
+
+        int victim = 0;
+        int victimValue = 1 << 30;
+        for (int j = 0; j < CLUSTER_SIZE; j++) {
+            uint64_t data = c.slots[j].data.load(std::memory_order_relaxed);
+            uint64_t check = c.slots[j].check.load(std::memory_order_relaxed);
+            if (data == 0) { victim = j; break; }
+            if ((check ^ data) == key) {
+                // On garde le meilleur coup connu si la nouvelle recherche n'en a pas
+                if (bestMove < 0) {
+                    TTEntry old;
+                    Unpack(data, old);
+                    bestMove = old.bestMove;
+                }
+                victim = j;
+                break;
+            }
+            int age = (uint8_t)(gen - (uint8_t)(data >> 56));
+            int value = (int)((data >> 32) & 0xFF) - 8 * age;
+            if (value < victimValue) { victimValue = value; victim = j; }
+        }
+
+        uint64_t data = (uint64_t)(uint32_t)score
+                      | (uint64_t)(uint8_t)depth << 32
+                      | (uint64_t)(uint8_t)(bestMove + 1) << 40
+                      | (uint64_t)bound << 48
+                      | (uint64_t)gen << 56;
+        c.slots[victim].check.store(key ^ data, std::memory_order_relaxed);
+        c.slots[victim].data.store(data, std::memory_order_relaxed);
+    }
+
+    // Taux de remplissage en pour mille (echantillon des 1000 premieres grappes)
+    int Hashfull() const {
+        size_t sample = clusterCount < 1000 ? clusterCount : 1000;
+        size_t used = 0;
+        uint8_t gen = generation.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < sample; i++) {
+            for (int j = 0; j < CLUSTER_SIZE; j++) {
+                uint64_t data = clusters[i].slots[j].data.load(std::memory_order_relaxed);
+                if (data != 0 && (uint8_t)(data >> 56) == gen) used++;
+            }
+        }
+        return (int)(used * 1000 / (sample * CLUSTER_SIZE));
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check; // cle ^ donnees
+        std::atomic<uint64_t> data;  // score | profondeur | coup + 1 | borne | generation
+    };
+    struct alignas(64) Cluster {
+        Slot slots[CLUSTER_SIZE];
+    };
+
+    static void Unpack(uint64_t data, TTEntry& out) {
+        out.score = (int)(uint32_t)data;
+        out.depth = (int)((data >> 32) & 0xFF);
+        out.bestMove = (int)((data >> 40) & 0xFF) - 1;
+        out.bound = (BoundType)((data >> 48) & 0x3);
+    }
+
+    std::unique_ptr<Cluster[]> clusters;
+    size_t clusterCount = 0;
+    std::atomic<uint8_t> generation{0};
+};
+
+#endif
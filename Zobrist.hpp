@@ -0,0 +1,67 @@
+#ifndef ZOBRIST_HPP
+#define ZOBRIST_HPP
+
+#include <cstdint>
+
+#include "Board.hpp"
+#include "Rng.hpp"
+
+// Hachage de Zobrist : une cle aleatoire par couple (trou, nombre de graines)
+// plus une cle pour le joueur au trait. Le hash d'une position est le XOR des
+// cles de ses trous ; un coup ne change que les trous qu'il touche.
+
+template <class B>
+struct ZobristKeys {
+    uint64_t pit[B::NUM_PITS][B::TOTAL_SEEDS + 1];
+    uint64_t side; // XOR quand le Joueur 2 (Haut) a le trait
+};
+
+template <class B>
+constexpr ZobristKeys<B> MakeZobristKeys() {
+    ZobristKeys<B> k = {};
+    uint64_t x = 0x4D414E43414C4131ULL; // "MANCALA1" : cles identiques d'une execution a l'autre (livre, fichiers)
+    for (int i = 0; i < B::NUM_PITS; i++) {
+        for (int c = 0; c <= B::TOTAL_SEEDS; c++) {
+            x = Rng::SplitMix(x);
+            k.pit[i][c] = x;
+        }
+    }
+    k.side = Rng::SplitMix(x);
+    return k;
+}
+
+template <class B>
+struct Zobrist {
+    static constexpr ZobristKeys<B> KEYS = MakeZobristKeys<B>();
+};
+
+// Hash complet (positions lues ou construites a la main)
+template <class B>
+inline uint64_t HashPosition(const B& b) {
+    uint64_t h = b.sideToMove ? Zobrist<B>::KEYS.side : 0;
+    for (int i = 0; i < B::NUM_PITS; i++) h ^= Zobrist<B>::KEYS.pit[i][b.seeds[i]];
+    return h;
+}
+
+// Mise a jour incrementale : on ne retouche que les trous dont le compte a change
+template <class B>
+inline uint64_t UpdateHash(uint64_t hash, const B& before, const B& after) {
+    for (int i = 0; i < B::NUM_PITS; i++) {
+        if (before.seeds[i] != after.seeds[i]) {
+            hash ^= Zobrist<B>::KEYS.pit[i][before.seeds[i]] ^ Zobrist<B>::KEYS.pit[i][after.seeds[i]];
+        }
+    }
+    if (before.sideToMove != after.sideToMove) hash ^= Zobrist<B>::KEYS.side;
+    return hash;
+}
+
+// ApplyMove qui tient le hash a jour
+template <class B>
+inline MoveResult ApplyMoveHashed(B& b, int pit, uint64_t& hash) {
+    B before = b;
+    MoveResult r = ApplyMove(b, pit);
+    hash = UpdateHash(hash, before, b);
+    return r;
+}
+
+#endif
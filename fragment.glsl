@@ -4,13 +4,24 @@ out vec4 FragColor;
 in vec3 Normal;
 in vec3 FragPos;
 in vec2 TexCoords;
+in vec3 InstanceColor;
+in float TextureIndex;
+
+// Commun a toute l'image (FrameUniforms dans Shader.hpp)
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec3 viewPos;
+    vec3 lightPos;
+    vec3 lightColor;
+    float ambientStrength;
+};
 
-uniform vec3 lightPos;
-uniform vec3 viewPos;
-uniform vec3 lightColor;
 uniform vec3 objectColor;
 uniform sampler2D texture1;
+uniform sampler2D texture2; // Deuxieme texture de la scene fixe (table)
 uniform bool useTexture;
+uniform bool worldSpace; // Couleur par instance ou par sommet au lieu de objectColor
 
 // Nouveaux boolens pour l'interface
 uniform bool isText;
@@ -39,7 +50,6 @@ void main()
     }
 
     // 3. RENDU 3D NORMAL (Bois, Graines...)
-    float ambientStrength = 0.45;
     vec3 ambient = ambientStrength * lightColor;
 
     vec3 norm = normalize(Normal);
@@ -53,9 +63,9 @@ void main()
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 64.0);
     vec3 specular = specularStrength * spec * lightColor;
 
-    vec4 baseColor = vec4(objectColor, 1.0);
+    vec4 baseColor = vec4(worldSpace ? InstanceColor : objectColor, 1.0);
     if (useTexture) {
-        vec4 texColor = texture(texture1, TexCoords);
+        vec4 texColor = TextureIndex > 0.5 ? texture(texture2, TexCoords) : texture(texture1, TexCoords);
         baseColor = mix(baseColor, texColor, 0.6);
     }
 
@@ -0,0 +1,920 @@
+// Outils sans fenetre (aucune dependance GL/GLFW) :
+//   mancala-headless selfplay [options]
+//   mancala-headless perft [options]
+//   mancala-headless egtb [options]
+//   mancala-headless book [options]
+//   mancala-headless simd [options]
+//   mancala-headless games FICHIER [options]
+//   mancala-headless analyze [options]
+//   mancala-headless tournament --engine P --engine P [...] [options]
+//   mancala-headless server [options]
+//   mancala-headless loadgen [options]
+//   mancala-headless train --records FICHIER [options]
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <csignal>
+#include <thread>
+#include <vector>
+
+#include "Analysis.hpp"
+#include "Board.hpp"
+#include "BoardSimd.hpp"
+#include "EndgameDb.hpp"
+#include "GameRecord.hpp"
+#include "GameServer.hpp"
+#include "LoadGen.hpp"
+#include "NetTrainer.hpp"
+#include "NeuralEval.hpp"
+#include "Notation.hpp"
+#include "OpeningBook.hpp"
+#include "Perft.hpp"
+#include "SelfPlay.hpp"
+#include "Tournament.hpp"
+
+// --- VARIANTES ---
+enum Variant { VARIANT_KALAH_6_4, VARIANT_KALAH_6_6, VARIANT_OWARE_6_4 };
+
+bool ParseVariant(const std::string& name, Variant& out) {
+    if (name == "kalah" || name == "kalah64") out = VARIANT_KALAH_6_4;
+    else if (name == "kalah66") out = VARIANT_KALAH_6_6;
+    else if (name == "oware" || name == "oware64") out = VARIANT_OWARE_6_4;
+    else return false;
+    return true;
+}
+
+// Instancie 'command' pour le type de plateau de la variante
+template <class Command>
+int WithVariant(Variant v, Command command) {
+    switch (v) {
+    case VARIANT_KALAH_6_6: return command(Kalah6x6());
+    case VARIANT_OWARE_6_4: return command(Oware6x4());
+    default:                return command(Kalah6x4());
+    }
+}
+
+// Variante d'une archive de parties, d'apres son en-tete
+bool RecordVariant(const GameRecordReader& reader, Variant& out) {
+    if (reader.IsFor<Kalah6x4>()) out = VARIANT_KALAH_6_4;
+    else if (reader.IsFor<Kalah6x6>()) out = VARIANT_KALAH_6_6;
+    else if (reader.IsFor<Oware6x4>()) out = VARIANT_OWARE_6_4;
+    else return false;
+    return true;
+}
+
+// Reseau des moteurs ":nn" (--net) : ouvert une fois, partage en lecture par tous les threads
+template <class B>
+bool AttachNet(const std::string& path, NeuralNet& net, PolicyConfig* policies, size_t count) {
+    bool wanted = false;
+    for (size_t i = 0; i < count; i++) wanted = wanted || policies[i].neural;
+    if (!wanted) return true;
+    if (path.empty()) { std::cerr << "Moteur :nn sans reseau (--net FICHIER)\n"; return false; }
+    if (!net.Open(path)) return false;
+    if (!net.IsFor<B>()) { std::cerr << "Reseau entraine pour une autre variante : " << path << "\n"; return false; }
+    for (size_t i = 0; i < count; i++) policies[i].net = &net;
+    return true;
+}
+
+void PrintUsage() {
+    std::cerr << "Usage : mancala-headless <commande> [options]\n"
+              << "\n"
+              << "  selfplay   Auto-jeu de N parties sur tous les coeurs\n"
+              << "    --games N          Nombre de parties (10000)\n"
+              << "    --threads N        Threads (0 = tous les coeurs)\n"
+              << "    --p1 POLITIQUE     random | greedy | search[:profondeur|:Nms][:nn] | mcts[:playouts|:Nms]\n"
+              << "    --p2 POLITIQUE     idem pour le Joueur 2 (random)\n"
+              << "    --seed N           Graine des generateurs (1)\n"
+              << "    --max-plies N      Coups max avant arret de la partie (1000)\n"
+              << "    --hash MO          Table de transposition par thread, en Mo (4)\n"
+              << "    --simd NIVEAU      scalar | ssse3 | avx2 (le meilleur disponible)\n"
+              << "    --record FICHIER   Ajoute les parties a une archive (sans les lots vectoriels)\n"
+              << "    --net FICHIER      Reseau d'evaluation des politiques search:...:nn (train)\n"
+              << "\n"
+              << "  perft      Compte les positions a exactement N demi-coups (profondeurs 1..N)\n"
+              << "    --depth N          Profondeur max (8)\n"
+              << "    --position \"P\"     Position de depart, ex. \"4,4,4,4,4,4,0,4,4,4,4,4,4,0 0\"\n"
+              << "    --divide           Detail par coup a la profondeur max\n"
+              << "    --unmake           Joue et defait les coups sur place (MakeMove / UnmakeMove) au lieu de copier\n"
+              << "    Depuis la position initiale, les comptes sont verifies contre la table de reference.\n"
+              << "\n"
+              << "  egtb       Genere la base de finales (Kalah) : toutes les positions a K graines en jeu max\n"
+              << "    --seeds K          Graines en jeu max (16, soit ~30 Mo pour 6 trous)\n"
+              << "    --out FICHIER      Fichier de sortie (kalah6.egdb, lu par le jeu 3D)\n"
+              << "\n"
+              << "  book       Genere le livre d'ouvertures par recherches profondes\n"
+              << "    --plies N          Demi-coups couverts depuis le depart (8)\n"
+              << "    --depth N          Profondeur de recherche par position (12)\n"
+              << "    --threads N        Threads (0 = tous les coeurs)\n"
+              << "    --out FICHIER      Fichier de sortie (kalah6x4.book, lu par le jeu 3D)\n"
+              << "\n"
+              << "  simd       Verifie les coups et evaluations par lots contre la version scalaire, puis les mesure\n"
+              << "    --positions N      Positions tirees de parties aleatoires (200000)\n"
+              << "    --net FICHIER      Verifie et mesure aussi le reseau d'evaluation (couche 1 incrementale, couches 2 et 3)\n"
+              << "\n"
+              << "  games      Relit une archive de parties (jeu 3D, selfplay --record) et rejoue chaque partie\n"
+              << "    --text             Une ligne par partie (mise au point)\n"
+              << "    --limit N          S'arreter apres N parties (0 = toutes)\n"
+              << "\n"
+              << "  analyze    Analyse des positions (une par ligne, notation de --position) ou des parties d'une archive,\n"
+              << "             sur tous les coeurs ; resultats dans l'ordre de l'entree : meilleur coup, score, PV\n"
+              << "    --input FICHIER    Positions a analyser (- = entree standard, par defaut)\n"
+              << "    --records FICHIER  Archive de parties : chaque position de chaque partie, avec le coup joue\n"
+              << "    --depth N          Profondeur max (12)\n"
+              << "    --time MS          Limite de temps par position (0 = profondeur seule)\n"
+              << "    --threads N        Threads (0 = tous les coeurs)\n"
+              << "    --hash MO          Table de transposition par thread, en Mo (16)\n"
+              << "    --egtb FICHIER     Base de finales (facultative)\n"
+              << "\n"
+              << "  tournament Reglages de l'ordinateur les uns contre les autres : Elo (intervalle a 95 %) et vitesse\n"
+              << "    --engine P         Un moteur (au moins deux), meme syntaxe que --p1,\n"
+              << "                       ex. search:8, search:50ms, search:8:eval=4,1,-1,2, search:8:nn, mcts:5000\n"
+              << "    --net FICHIER      Reseau d'evaluation des moteurs :nn\n"
+              << "    --gauntlet         Le premier moteur contre chacun des autres (sinon toutes rondes)\n"
+              << "    --openings N       Ouvertures equilibrees, chacune jouee dans les deux sens (50)\n"
+              << "    --opening-plies N  Demi-coups aleatoires par ouverture (4)\n"
+              << "    --threads N        Threads (0 = tous les coeurs)\n"
+              << "    --seed N           Graine (1)\n"
+              << "\n"
+              << "  server     Serveur de parties (epoll, Linux) : clients apparies deux a deux ou contre l'ordinateur\n"
+              << "    --listen ADRESSE   hote:port, :port ou unix:/chemin, repetable (:7777)\n"
+              << "    --ai-depth N       Profondeur de l'ordinateur du serveur (6)\n"
+              << "    Arret par Ctrl+C : bilan des connexions, parties et coups\n"
+              << "\n"
+              << "  loadgen    Generateur de charge : N clients jouent au hasard, latences coup -> deroulement\n"
+              << "    --connect ADRESSE  Serveur (:7777)\n"
+              << "    --clients N        Connexions simultanees (200)\n"
+              << "    --games N          Parties a terminer (2000)\n"
+              << "    --vs-ai            Contre l'ordinateur du serveur (sinon les clients s'affrontent)\n"
+              << "    --spawn            Lance le serveur dans le processus, sur l'adresse de --connect\n"
+              << "    --ai-depth N       Profondeur de l'ordinateur du serveur lance par --spawn (6)\n"
+              << "    --timeout S        Abandon si les parties ne sont pas finies apres S secondes (120)\n"
+              << "    --seed N           Graine (1)\n"
+              << "\n"
+              << "  train      Entraine le reseau d'evaluation sur une archive de parties (selfplay --record)\n"
+              << "    --records FICHIER  Archive de parties (la variante en vient)\n"
+              << "    --out FICHIER      Reseau quantifie (kalah6x4.nn, lu par le jeu 3D avec --net)\n"
+              << "    --epochs N         Passes sur les exemples (20)\n"
+              << "    --batch N          Exemples par pas d'Adam (256)\n"
+              << "    --rate X           Pas d'apprentissage (0.001)\n"
+              << "    --seed N           Graine (1)\n"
+              << "\n"
+              << "  Option commune : --variant kalah64 | kalah66 | oware64 (kalah64)\n";
+}
+
+// --- AUTO-JEU ---
+int CommandSelfPlay(int argc, char** argv) {
+    SelfPlayConfig cfg;
+    Variant variant = VARIANT_KALAH_6_4;
+    std::string recordPath, netPath;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--games") cfg.games = std::atol(value);
+        else if (arg == "--threads") cfg.threads = std::atoi(value);
+        else if (arg == "--seed") cfg.seed = std::strtoull(value, nullptr, 10);
+        else if (arg == "--max-plies") cfg.maxPlies = std::atoi(value);
+        else if (arg == "--hash") cfg.hashMb = std::atoi(value);
+        else if (arg == "--record") recordPath = value;
+        else if (arg == "--net") netPath = value;
+        else if (arg == "--simd") {
+            SimdLevel level;
+            if (!ParseSimdLevel(value, level)) { std::cerr << "Niveau SIMD inconnu : " << value << "\n"; return 1; }
+            if (!SetSimdLevel(level)) { std::cerr << "Niveau SIMD non gere par ce processeur : " << value << "\n"; return 1; }
+        }
+        else if (arg == "--p1" || arg == "--p2") {
+            if (!ParsePolicy(value, cfg.players[arg == "--p1" ? 0 : 1])) { std::cerr << "Politique inconnue : " << value << "\n"; return 1; }
+        }
+        else if (arg == "--variant") {
+            if (!ParseVariant(value, variant)) { std::cerr << "Variante inconnue : " << value << "\n"; return 1; }
+        }
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        NeuralNet net;
+        if (!AttachNet<B>(netPath, net, cfg.players, 2)) return 1;
+        GameRecordWriter record;
+        if (!recordPath.empty()) {
+            if (!record.Open<B>(recordPath)) return 1;
+            cfg.record = &record;
+        }
+        SelfPlayStats s = RunSelfPlay<B>(cfg);
+
+        double games = s.games > 0 ? (double)s.games : 1.0;
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Parties       : " << s.games << " (" << PolicyName(cfg.players[0]) << " vs " << PolicyName(cfg.players[1]) << ")\n"
+                  << "Temps         : " << s.seconds << " s\n"
+                  << "Parties/s     : " << (s.seconds > 0 ? s.games / s.seconds : 0.0) << "\n"
+                  << "Coups/partie  : " << s.plies / games << "\n"
+                  << "Victoires J1  : " << 100.0 * s.wins[0] / games << " %\n"
+                  << "Victoires J2  : " << 100.0 * s.wins[1] / games << " %\n"
+                  << "Egalites      : " << 100.0 * s.draws / games << " %\n"
+                  << "SIMD          : " << SimdLevelName(ActiveSimdLevel()) << "\n";
+        if (s.truncated > 0) std::cout << "Arretees      : " << s.truncated << " (max-plies)\n";
+        return 0;
+    });
+}
+
+// --- PERFT ---
+int CommandPerft(int argc, char** argv) {
+    int depth = 8;
+    bool divide = false;
+    bool unmake = false;
+    std::string position;
+    Variant variant = VARIANT_KALAH_6_4;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--divide") { divide = true; continue; }
+        if (arg == "--unmake") { unmake = true; continue; }
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--depth") depth = std::atoi(value);
+        else if (arg == "--position") position = value;
+        else if (arg == "--variant") {
+            if (!ParseVariant(value, variant)) { std::cerr << "Variante inconnue : " << value << "\n"; return 1; }
+        }
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        typedef PerftReference<B> Reference;
+
+        B start = B::Initial();
+        bool fromInitial = position.empty();
+        if (!fromInitial && !ParsePosition(position, start)) {
+            std::cerr << "Position invalide (attendu " << B::NUM_PITS << " compteurs totalisant " << B::TOTAL_SEEDS << " puis le joueur 0/1)\n";
+            return 1;
+        }
+
+        std::cout << "Position : " << FormatPosition(start) << "\n";
+        int failures = 0;
+        for (int d = 1; d <= depth; d++) {
+            auto t0 = std::chrono::steady_clock::now();
+            B scratch = start;
+            uint64_t nodes = unmake ? PerftUnmake(scratch, d) : Perft(start, d);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+            std::cout << "perft(" << std::setw(2) << d << ") = " << std::setw(12) << nodes
+                      << "  " << std::fixed << std::setprecision(3) << seconds << " s  "
+                      << std::setprecision(0) << (seconds > 0 ? nodes / seconds : 0.0) << " noeuds/s";
+            if (fromInitial && d < Reference::COUNT) {
+                bool ok = nodes == Reference::VALUES[d];
+                if (!ok) failures++;
+                std::cout << (ok ? "  OK" : "  ECHEC (attendu " + std::to_string(Reference::VALUES[d]) + ")");
+            }
+            if (std::memcmp(&scratch, &start, sizeof(B)) != 0) {
+                failures++;
+                std::cout << "  ECHEC (plateau non restaure par UnmakeMove)";
+            }
+            std::cout << "\n";
+        }
+
+        if (divide && depth >= 1 && !IsTerminal(start)) {
+            typename B::MoveList moves = LegalMoves(start);
+            for (int i = 0; i < moves.count; i++) {
+                B child = start;
+                ApplyMove(child, moves.moves[i]);
+                std::cout << "  trou " << std::setw(2) << moves.moves[i] << " : " << Perft(child, depth - 1) << "\n";
+            }
+        }
+        return failures > 0 ? 2 : 0;
+    });
+}
+
+// --- BASE DE FINALES ---
+int CommandEndgame(int argc, char** argv) {
+    int maxSeeds = 16;
+    std::string path = "kalah6.egdb";
+    Variant variant = VARIANT_KALAH_6_4;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--seeds") maxSeeds = std::atoi(value);
+        else if (arg == "--out") path = value;
+        else if (arg == "--variant") {
+            if (!ParseVariant(value, variant)) { std::cerr << "Variante inconnue : " << value << "\n"; return 1; }
+        }
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        auto t0 = std::chrono::steady_clock::now();
+        EndgameBuilder<B> builder;
+        if (!builder.Build(maxSeeds)) return 1;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if (!builder.Write(path)) return 1;
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Positions     : " << builder.Count() << " (" << B::PITS_PER_SIDE << " trous par camp, <= " << maxSeeds << " graines)\n"
+                  << "Temps         : " << seconds << " s\n"
+                  << "Fichier       : " << path << " (" << (sizeof(EndgameHeader) + builder.Count()) / (1024.0 * 1024.0) << " Mo)\n";
+        return 0;
+    });
+}
+
+// --- LIVRE D'OUVERTURES ---
+int CommandBook(int argc, char** argv) {
+    BookConfig cfg;
+    std::string path = "kalah6x4.book";
+    Variant variant = VARIANT_KALAH_6_4;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--plies") cfg.plies = std::atoi(value);
+        else if (arg == "--depth") cfg.depth = std::atoi(value);
+        else if (arg == "--threads") cfg.threads = std::atoi(value);
+        else if (arg == "--out") path = value;
+        else if (arg == "--variant") {
+            if (!ParseVariant(value, variant)) { std::cerr << "Variante inconnue : " << value << "\n"; return 1; }
+        }
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<BookEntry> entries = BuildBook<B>(cfg);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if (!WriteBook<B>(path, entries)) return 1;
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Positions     : " << entries.size() << " (" << cfg.plies << " demi-coups, profondeur " << cfg.depth << ")\n"
+                  << "Temps         : " << seconds << " s\n"
+                  << "Fichier       : " << path << " (" << (sizeof(BookHeader) + entries.size() * sizeof(BookEntry)) / 1024.0 << " Ko)\n";
+        return 0;
+    });
+}
+
+// --- COUPS ET EVALUATIONS PAR LOTS ---
+int CommandSimd(int argc, char** argv) {
+    long count = 200000;
+    Variant variant = VARIANT_KALAH_6_4;
+    std::string netPath;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--positions") count = std::atol(value);
+        else if (arg == "--net") netPath = value;
+        else if (arg == "--variant") {
+            if (!ParseVariant(value, variant)) { std::cerr << "Variante inconnue : " << value << "\n"; return 1; }
+        }
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        typedef std::chrono::steady_clock Clock;
+
+        // Positions et coups tires de parties aleatoires
+        Rng rng(1);
+        std::vector<PackedBoard<B>> positions;
+        std::vector<uint8_t> moves;
+        while ((long)positions.size() < count) {
+            B b = B::Initial();
+            for (int ply = 0; ply < 1000 && !IsTerminal(b) && (long)positions.size() < count; ply++) {
+                typename B::MoveList list = LegalMoves(b);
+                int move = list.moves[rng.Below(list.count)];
+                PackedBoard<B> p = PackedBoard<B>();
+                p.board = b;
+                positions.push_back(p);
+                moves.push_back((uint8_t)move);
+                ApplyMove(b, move);
+            }
+        }
+        int n = (int)positions.size();
+
+        std::vector<PackedBoard<B>> expected = positions;
+        std::vector<MoveResult> expectedResults(n);
+        std::vector<BoardFeatures> expectedFeatures(n);
+        ApplyMovesBatch(expected.data(), moves.data(), n, expectedResults.data(), SIMD_SCALAR);
+        EvaluateBatch(positions.data(), n, expectedFeatures.data(), SIMD_SCALAR);
+
+        std::cout << "Positions : " << n << " (processeur : " << SimdLevelName(DetectSimdLevel()) << ")\n";
+        int failures = 0;
+        for (int level = SIMD_SCALAR; level <= DetectSimdLevel(); level++) {
+            SimdLevel simd = (SimdLevel)level;
+            std::vector<PackedBoard<B>> played = positions;
+            std::vector<MoveResult> results(n);
+            std::vector<BoardFeatures> features(n);
+
+            auto t0 = Clock::now();
+            ApplyMovesBatch(played.data(), moves.data(), n, results.data(), simd);
+            double applySeconds = std::chrono::duration<double>(Clock::now() - t0).count();
+            t0 = Clock::now();
+            EvaluateBatch(positions.data(), n, features.data(), simd);
+            double evalSeconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+            int mismatches = 0;
+            for (int i = 0; i < n; i++) {
+                const MoveResult& a = results[i];
+                const MoveResult& e = expectedResults[i];
+                const BoardFeatures& f = features[i];
+                const BoardFeatures& g = expectedFeatures[i];
+                if (std::memcmp(&played[i].board, &expected[i].board, sizeof(B)) != 0 || a.lastPit != e.lastPit
+                    || a.captured != e.captured || a.extraTurn != e.extraTurn || a.gameOver != e.gameOver
+                    || f.storeDiff != g.storeDiff || f.ownSeeds != g.ownSeeds || f.otherSeeds != g.otherSeeds || f.captures != g.captures) {
+                    mismatches++;
+                }
+            }
+            if (mismatches > 0) failures++;
+
+            std::cout << std::setw(7) << SimdLevelName(simd) << " : coups " << std::fixed << std::setprecision(1)
+                      << (applySeconds > 0 ? n / applySeconds / 1e6 : 0.0) << " M/s, evaluations "
+                      << (evalSeconds > 0 ? n / evalSeconds / 1e6 : 0.0) << " M/s"
+                      << (mismatches == 0 ? "  OK" : "  ECHEC (" + std::to_string(mismatches) + " differences)") << "\n";
+        }
+
+        // Reseau : accumulateur de l'enfant deduit du parent (Update) contre recalcul, sortie contre le scalaire
+        NeuralNet net;
+        if (!netPath.empty()) {
+            if (!net.Open(netPath)) return 1;
+            if (!net.IsFor<B>()) { std::cerr << "Reseau entraine pour une autre variante : " << netPath << "\n"; return 1; }
+            std::vector<NnAccumulator> parents(n);
+            std::vector<int> outputs(n), got(n);
+            SimdLevel active = ActiveSimdLevel();
+            for (int i = 0; i < n; i++) {
+                NnAccumulator child;
+                net.Refresh(positions[i].board, parents[i]);
+                net.Refresh(expected[i].board, child);
+                outputs[i] = NnForwardScalar(net.Weights(), child, expected[i].board.sideToMove);
+            }
+            for (int level = SIMD_SCALAR; level <= DetectSimdLevel(); level++) {
+                SetSimdLevel((SimdLevel)level);
+                NnAccumulator acc, fresh;
+                auto t0 = Clock::now();
+                for (int i = 0; i < n; i++) {
+                    net.Update(parents[i], positions[i].board, expected[i].board, acc);
+                    got[i] = net.Forward(acc, expected[i].board.sideToMove);
+                }
+                double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+                int mismatches = 0;
+                for (int i = 0; i < n; i++) {
+                    net.Update(parents[i], positions[i].board, expected[i].board, acc);
+                    net.Refresh(expected[i].board, fresh);
+                    if (std::memcmp(&acc, &fresh, sizeof(acc)) != 0 || got[i] != outputs[i]) mismatches++;
+                }
+                if (mismatches > 0) failures++;
+                std::cout << std::setw(7) << SimdLevelName((SimdLevel)level) << " : reseau " << std::fixed << std::setprecision(1)
+                          << (seconds > 0 ? n / seconds / 1e6 : 0.0) << " M evaluations/s (couche 1 incrementale)"
+                          << (mismatches == 0 ? "  OK" : "  ECHEC (" + std::to_string(mismatches) + " differences)") << "\n";
+            }
+            SetSimdLevel(active);
+        }
+        return failures > 0 ? 2 : 0;
+    });
+}
+
+// --- ARCHIVE DE PARTIES ---
+int CommandGames(int argc, char** argv) {
+    if (argc < 1) { PrintUsage(); return 1; }
+    std::string path = argv[0];
+    bool text = false;
+    long limit = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--text") { text = true; continue; }
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--limit") limit = std::atol(value);
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+
+    GameRecordReader reader;
+    if (!reader.Open(path)) return 1;
+    Variant variant;
+    if (!RecordVariant(reader, variant)) { std::cerr << "Variante de l'archive non geree : " << path << "\n"; return 1; }
+
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        auto t0 = std::chrono::steady_clock::now();
+        long games = 0, plies = 0, invalid = 0;
+        long results[4] = {0, 0, 0, 0};
+        GameRecordView g;
+        while ((limit <= 0 || games < limit) && reader.Next(g)) {
+            B final;
+            if (!ReplayGameRecord(g, final)) {
+                invalid++;
+                std::cout << "Partie " << g.index << " invalide (coup illegal ou magasins differents)\n";
+            }
+            if (text) std::cout << FormatGameRecord(g) << "\n";
+            games++;
+            plies += g.header.moveCount;
+            results[g.header.result <= RESULT_UNFINISHED ? g.header.result : (int)RESULT_UNFINISHED]++;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        double n = games > 0 ? (double)games : 1.0;
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Parties       : " << games << "\n"
+                  << "Coups/partie  : " << plies / n << "\n"
+                  << "Victoires J1  : " << 100.0 * results[RESULT_P1_WINS] / n << " %\n"
+                  << "Victoires J2  : " << 100.0 * results[RESULT_P2_WINS] / n << " %\n"
+                  << "Egalites      : " << 100.0 * results[RESULT_DRAW] / n << " %\n"
+                  << "Inachevees    : " << results[RESULT_UNFINISHED] << "\n"
+                  << "Parties/s     : " << std::setprecision(0) << (seconds > 0 ? games / seconds : 0.0) << " (relues et rejouees)\n";
+        if (reader.Truncated()) std::cout << "Derniere partie incomplete (ignoree)\n";
+        return invalid > 0 ? 2 : 0;
+    });
+}
+
+// --- ANALYSE EN LOT ---
+std::string FormatPv(const SearchResult& r) {
+    std::string s;
+    for (int i = 0; i < r.pvLength; i++) s += (i > 0 ? " " : "") + std::to_string(r.pv[i]);
+    return s;
+}
+
+int CommandAnalyze(int argc, char** argv) {
+    AnalysisConfig cfg;
+    std::string inputPath = "-", recordsPath, egtbPath;
+    Variant variant = VARIANT_KALAH_6_4;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--input") inputPath = value;
+        else if (arg == "--records") recordsPath = value;
+        else if (arg == "--depth") cfg.depth = std::atoi(value);
+        else if (arg == "--time") cfg.timeMs = std::atoi(value);
+        else if (arg == "--threads") cfg.threads = std::atoi(value);
+        else if (arg == "--hash") cfg.hashMb = std::atoi(value);
+        else if (arg == "--egtb") egtbPath = value;
+        else if (arg == "--variant") {
+            if (!ParseVariant(value, variant)) { std::cerr << "Variante inconnue : " << value << "\n"; return 1; }
+        }
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+
+    GameRecordReader reader;
+    if (!recordsPath.empty()) {
+        if (!reader.Open(recordsPath)) return 1;
+        if (!RecordVariant(reader, variant)) { std::cerr << "Variante de l'archive non geree : " << recordsPath << "\n"; return 1; }
+    }
+    std::ifstream file;
+    if (recordsPath.empty() && inputPath != "-") {
+        file.open(inputPath.c_str());
+        if (!file) { std::cerr << "Impossible de lire " << inputPath << "\n"; return 1; }
+    }
+    std::istream& input = file.is_open() ? (std::istream&)file : std::cin;
+    EndgameTable egtb;
+    if (!egtbPath.empty() && !egtb.Open(egtbPath)) return 1;
+
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        int invalid = 0;
+
+        // Positions texte : une par ligne ('#' = commentaire), numerotees par leur ligne
+        uint64_t lineNumber = 0;
+        auto textSource = [&](AnalysisItem<B>& item) {
+            std::string line;
+            while (std::getline(input, line)) {
+                lineNumber++;
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                size_t first = line.find_first_not_of(" \t");
+                if (first == std::string::npos || line[first] == '#') continue;
+                if (!ParsePosition(line, item.position)) {
+                    std::cerr << "Ligne " << lineNumber << " : position invalide ignoree\n";
+                    invalid++;
+                    continue;
+                }
+                item.game = lineNumber;
+                return true;
+            }
+            return false;
+        };
+
+        // Archive : chaque position avant un coup, partie apres partie
+        GameRecordView game;
+        bool inGame = false;
+        B current;
+        int ply = 0;
+        auto recordSource = [&](AnalysisItem<B>& item) {
+            for (;;) {
+                if (!inGame) {
+                    if (!reader.Next(game)) return false;
+                    inGame = true;
+                    current = B::Initial();
+                    ply = 0;
+                }
+                if (ply < game.header.moveCount && !IsTerminal(current) && IsLegalMove(current, game.moves[ply])) {
+                    item.position = current;
+                    item.played = game.moves[ply];
+                    item.game = game.index;
+                    item.ply = ply;
+                    ApplyMove(current, game.moves[ply++]);
+                    return true;
+                }
+                if (ply < game.header.moveCount) {
+                    std::cerr << "Partie " << game.index << " : coup " << ply << " illegal, fin de partie ignoree\n";
+                    invalid++;
+                }
+                inGame = false;
+            }
+        };
+
+        auto sink = [&](const AnalysisItem<B>& item, const SearchResult& r) {
+            if (item.played >= 0) {
+                std::cout << "partie " << item.game << " coup " << item.ply << " J" << item.position.sideToMove + 1
+                          << " : joue " << item.played << (item.played == r.bestMove ? " = " : " ? ") << "meilleur " << r.bestMove;
+            } else {
+                std::cout << item.game << " : " << FormatPosition(item.position) << " : meilleur " << r.bestMove;
+            }
+            std::cout << " | score " << FormatScore(r.score, r.exact) << " | profondeur " << r.depth << " | PV " << FormatPv(r) << "\n";
+        };
+
+        AnalysisStats s = recordsPath.empty()
+            ? AnalyzeStream<B>(cfg, textSource, sink, egtb.IsOpen() ? &egtb : nullptr)
+            : AnalyzeStream<B>(cfg, recordSource, sink, egtb.IsOpen() ? &egtb : nullptr);
+        std::cout.flush();
+
+        std::cerr << std::fixed << std::setprecision(2)
+                  << "Positions     : " << s.positions << " en " << s.seconds << " s ("
+                  << std::setprecision(0) << (s.seconds > 0 ? s.positions / s.seconds : 0.0) << " positions/s, "
+                  << (s.seconds > 0 ? s.nodes / s.seconds : 0.0) << " noeuds/s)\n";
+        return invalid > 0 ? 2 : 0;
+    });
+}
+
+// --- TOURNOI ---
+int CommandTournament(int argc, char** argv) {
+    TournamentConfig cfg;
+    Variant variant = VARIANT_KALAH_6_4;
+    std::string netPath;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--gauntlet") { cfg.mode = TOURNAMENT_GAUNTLET; continue; }
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--engine") {
+            PolicyConfig p;
+            if (!ParsePolicy(value, p)) { std::cerr << "Moteur inconnu : " << value << "\n"; return 1; }
+            cfg.engines.push_back(p);
+        }
+        else if (arg == "--net") netPath = value;
+        else if (arg == "--openings") cfg.openings = std::atoi(value);
+        else if (arg == "--opening-plies") cfg.openingPlies = std::atoi(value);
+        else if (arg == "--threads") cfg.threads = std::atoi(value);
+        else if (arg == "--hash") cfg.hashMb = std::atoi(value);
+        else if (arg == "--max-plies") cfg.maxPlies = std::atoi(value);
+        else if (arg == "--seed") cfg.seed = std::strtoull(value, nullptr, 10);
+        else if (arg == "--variant") {
+            if (!ParseVariant(value, variant)) { std::cerr << "Variante inconnue : " << value << "\n"; return 1; }
+        }
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+    if (cfg.engines.size() < 2) { std::cerr << "Il faut au moins deux --engine\n"; return 1; }
+
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        NeuralNet net;
+        if (!AttachNet<B>(netPath, net, cfg.engines.data(), cfg.engines.size())) return 1;
+        TournamentResult r = RunTournament<B>(cfg);
+        if (r.openings == 0) { std::cerr << "Aucune ouverture equilibree trouvee\n"; return 1; }
+
+        std::cout << "Ouvertures    : " << r.openings << " (" << cfg.openingPlies << " demi-coups, a " << cfg.openingMargin
+                  << " graines pres)\n"
+                  << "Parties       : " << r.games << " en " << std::fixed << std::setprecision(1) << r.seconds << " s ("
+                  << (cfg.mode == TOURNAMENT_GAUNTLET ? "gauntlet" : "toutes rondes") << ")\n\n";
+
+        std::vector<int> order(cfg.engines.size());
+        for (size_t i = 0; i < order.size(); i++) order[i] = (int)i;
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return r.engines[a].elo > r.engines[b].elo; });
+        std::cout << "  Moteur                          Elo     +/-   Score  Parties     Noeuds/s\n";
+        for (int e : order) {
+            const EngineResult& s = r.engines[e];
+            std::cout << "  " << std::left << std::setw(28) << PolicyName(cfg.engines[e]) << std::right << std::showpos
+                      << std::setw(8) << std::setprecision(0) << s.elo << std::noshowpos << std::setw(8) << s.eloMargin
+                      << std::setw(7) << std::setprecision(1) << (s.games > 0 ? 100.0 * s.points / s.games : 0.0) << " %"
+                      << std::setw(9) << s.games << std::setw(13) << std::setprecision(0);
+            if (s.nodes > 0 && s.seconds > 0) std::cout << s.nodes / s.seconds << "\n";
+            else std::cout << "-" << "\n"; // Pas de recherche (random, greedy)
+        }
+
+        std::cout << "\n";
+        for (const PairResult& p : r.pairs) {
+            long n = p.wins + p.draws + p.losses;
+            double score = n > 0 ? (p.wins + 0.5 * p.draws) / n : 0.5;
+            std::cout << "  " << PolicyName(cfg.engines[p.a]) << " vs " << PolicyName(cfg.engines[p.b]) << " : +" << p.wins
+                      << " =" << p.draws << " -" << p.losses << " (" << std::setprecision(1) << 100.0 * score << " %)  Elo "
+                      << std::showpos << std::setprecision(0) << EloFromScore(score) << std::noshowpos << " +/- "
+                      << EloMargin(p.wins, p.draws, p.losses) << "\n";
+        }
+        return 0;
+    });
+}
+
+// --- SERVEUR DE PARTIES ---
+std::atomic<bool> serverStop(false);
+
+void StopServer(int) { serverStop = true; }
+
+int CommandServer(int argc, char** argv) {
+    ServerConfig cfg;
+    Variant variant = VARIANT_KALAH_6_4;
+    std::vector<NetAddress> addresses;
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--listen") {
+            NetAddress a;
+            if (!ParseNetAddress(value, a)) { std::cerr << "Adresse invalide : " << value << "\n"; return 1; }
+            addresses.push_back(a);
+        }
+        else if (arg == "--ai-depth") cfg.aiDepth = std::atoi(value);
+        else if (arg == "--variant") {
+            if (!ParseVariant(value, variant)) { std::cerr << "Variante inconnue : " << value << "\n"; return 1; }
+        }
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+    if (addresses.empty()) {
+        addresses.emplace_back();
+        ParseNetAddress(":7777", addresses.back());
+    }
+
+    RaiseFileLimit();
+    std::signal(SIGINT, StopServer);
+    std::signal(SIGTERM, StopServer);
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        GameServer<B> server(cfg);
+        for (const NetAddress& a : addresses) {
+            if (!server.Listen(a)) return 1;
+            std::cerr << "Ecoute sur " << FormatNetAddress(a) << "\n";
+        }
+        server.Run(serverStop);
+
+        const ServerStats& s = server.Stats();
+        std::cout << "Connexions    : " << s.accepted << " (max " << s.peakConnections << " simultanees)\n"
+                  << "Parties       : " << s.matches << "\n"
+                  << "Coups         : " << s.moves << "\n"
+                  << "Trames        : " << s.frames << " recues, " << s.bytesIn << " octets recus, " << s.bytesOut
+                  << " envoyes\n";
+        return 0;
+    });
+}
+
+// --- GENERATEUR DE CHARGE ---
+int CommandLoadGen(int argc, char** argv) {
+    LoadGenConfig cfg;
+    ServerConfig serverCfg;
+    Variant variant = VARIANT_KALAH_6_4;
+    bool spawn = false;
+    ParseNetAddress(":7777", cfg.address);
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--vs-ai") { cfg.vsAi = true; continue; }
+        if (arg == "--spawn") { spawn = true; continue; }
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--connect") {
+            if (!ParseNetAddress(value, cfg.address)) { std::cerr << "Adresse invalide : " << value << "\n"; return 1; }
+        }
+        else if (arg == "--clients") cfg.clients = std::atoi(value);
+        else if (arg == "--games") cfg.games = std::atol(value);
+        else if (arg == "--ai-depth") serverCfg.aiDepth = std::atoi(value);
+        else if (arg == "--timeout") cfg.timeoutSeconds = std::atoi(value);
+        else if (arg == "--seed") cfg.seed = std::strtoull(value, nullptr, 10);
+        else if (arg == "--variant") {
+            if (!ParseVariant(value, variant)) { std::cerr << "Variante inconnue : " << value << "\n"; return 1; }
+        }
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+    if (cfg.clients < 1 || (!cfg.vsAi && cfg.clients < 2)) { std::cerr << "Pas assez de clients\n"; return 1; }
+
+    RaiseFileLimit();
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        // --spawn : serveur dans un second thread, meme processus (mesure sur la boucle locale)
+        GameServer<B> server(serverCfg);
+        std::atomic<bool> stop(false);
+        std::thread serverThread;
+        if (spawn) {
+            if (!server.Listen(cfg.address)) return 1;
+            serverThread = std::thread([&]() { server.Run(stop); });
+        }
+
+        LoadGenReport r = RunLoadGen<B>(cfg);
+
+        if (spawn) {
+            stop = true;
+            serverThread.join();
+        }
+        std::cout << std::fixed << std::setprecision(2)
+                  << "Clients       : " << r.connected << " connectes sur " << cfg.clients << " ("
+                  << FormatNetAddress(cfg.address) << (cfg.vsAi ? ", contre l'ordinateur" : ", entre eux") << ")\n"
+                  << "Parties       : " << r.games << " en " << r.seconds << " s" << (r.timedOut ? " (delai depasse)" : "")
+                  << "\n"
+                  << "Coups         : " << r.moves << " (" << std::setprecision(0) << (r.seconds > 0 ? r.moves / r.seconds : 0.0)
+                  << " coups/s)\n"
+                  << "Latence (us)  : p50 " << r.Percentile(0.50) << "  p90 " << r.Percentile(0.90) << "  p99 "
+                  << r.Percentile(0.99) << "  p99.9 " << r.Percentile(0.999) << "  max "
+                  << (r.latencyUs.empty() ? 0 : r.latencyUs.back()) << "\n"
+                  << "Erreurs       : " << r.errors << "\n";
+        return r.errors > 0 || r.timedOut ? 2 : 0;
+    });
+}
+
+// --- ENTRAINEMENT DU RESEAU ---
+int CommandTrain(int argc, char** argv) {
+    TrainerConfig cfg;
+    std::string recordsPath, path = "kalah6x4.nn";
+
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { std::cerr << "Valeur manquante pour " << arg << "\n"; return 1; }
+        i++;
+        if (arg == "--records") recordsPath = value;
+        else if (arg == "--out") path = value;
+        else if (arg == "--epochs") cfg.epochs = std::atoi(value);
+        else if (arg == "--batch") cfg.batch = std::atoi(value);
+        else if (arg == "--rate") cfg.learningRate = std::atof(value);
+        else if (arg == "--seed") cfg.seed = std::strtoull(value, nullptr, 10);
+        else { std::cerr << "Option inconnue : " << arg << "\n"; PrintUsage(); return 1; }
+    }
+    if (recordsPath.empty()) { std::cerr << "Il faut une archive de parties (--records)\n"; return 1; }
+    if (cfg.batch < 1) cfg.batch = 1;
+
+    GameRecordReader reader;
+    if (!reader.Open(recordsPath)) return 1;
+    Variant variant;
+    if (!RecordVariant(reader, variant)) { std::cerr << "Variante de l'archive non geree : " << recordsPath << "\n"; return 1; }
+
+    return WithVariant(variant, [&](auto board) {
+        typedef decltype(board) B;
+        auto t0 = std::chrono::steady_clock::now();
+        TrainerReport r;
+        std::unique_ptr<NetTrainer<B>> trainer(new NetTrainer<B>());
+        if (!trainer->Load(reader, r)) { std::cerr << "Pas assez de parties achevees dans " << recordsPath << "\n"; return 1; }
+        std::cout << "Exemples      : " << r.samples << " (+ " << r.validation << " de validation, " << r.games << " parties)\n";
+        trainer->Train(cfg, r);
+
+        std::unique_ptr<NetWeights> weights(new NetWeights());
+        trainer->Quantize(*weights);
+        if (!WriteNet<B>(path, *weights)) return 1;
+        NeuralNet net;
+        if (!net.Open(path)) return 1;
+        r.quantizedMse = trainer->QuantizedMse(net);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Erreur (graines^2, validation)\n"
+                  << "  magasins    : " << r.baselineMse << "\n"
+                  << "  reseau reel : " << r.floatMse << "\n"
+                  << "  quantifie   : " << r.quantizedMse << "\n"
+                  << "Temps         : " << std::setprecision(1) << seconds << " s\n"
+                  << "Fichier       : " << path << " (" << (sizeof(NetHeader) + sizeof(NetWeights)) / 1024.0 << " Ko)\n";
+        return 0;
+    });
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { PrintUsage(); return 1; }
+    std::string command = argv[1];
+    if (command == "selfplay") return CommandSelfPlay(argc - 2, argv + 2);
+    if (command == "perft") return CommandPerft(argc - 2, argv + 2);
+    if (command == "egtb") return CommandEndgame(argc - 2, argv + 2);
+    if (command == "book") return CommandBook(argc - 2, argv + 2);
+    if (command == "simd") return CommandSimd(argc - 2, argv + 2);
+    if (command == "games") return CommandGames(argc - 2, argv + 2);
+    if (command == "analyze") return CommandAnalyze(argc - 2, argv + 2);
+    if (command == "tournament") return CommandTournament(argc - 2, argv + 2);
+    if (command == "server") return CommandServer(argc - 2, argv + 2);
+    if (command == "loadgen") return CommandLoadGen(argc - 2, argv + 2);
+    if (command == "train") return CommandTrain(argc - 2, argv + 2);
+    PrintUsage();
+    return 1;
+}
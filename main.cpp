@@ -6,6 +6,7 @@
 #include <ctime>
 #include <string>
 #include <cmath>
+#include <cstring>
 
 #include "Shader.hpp"
 #include "Camera.hpp"
@@ -28,6 +29,7 @@ bool firstMouse = true;
 bool cursorEnabled = true;
 
 MancalaGame game;
+typedef MancalaGame::BoardType GameBoard; // Variante jouee (Kalah 6 trous, 4 graines)
 float deltaTime = 0.0f;
 float lastFrame = 0.0f;
 
@@ -52,9 +54,36 @@ std::vector<Theme> themes;
 struct SeedVisual { glm::vec3 offset; int colorType; };
 std::vector<std::vector<SeedVisual>> pitSeedsVisuals;
 
+// Graines dessinees d'un seul appel instancie : celles des trous, puis celle en mouvement
+const int SEED_INSTANCE_CAPACITY = GameBoard::TOTAL_SEEDS + 1;
+unsigned int seedInstanceVBO;
+std::vector<InstanceData> seedInstances;
+uint8_t shownSeeds[GameBoard::NUM_PITS]; // Comptes dont le tampon est le reflet
+int shownSeedTheme = -1;
+
+// Scene fixe (plateau, bordures, table) : un maillage en coordonnees du monde, voir BakeStaticScene
+int staticSceneTheme = -1; // Theme dont les teintes sont dans le maillage
+size_t staticSceneBoardEnd = 0, staticSceneBordersEnd = 0; // Fin du plateau, puis des bordures (sommets)
+
+// Trous : bols de rayon PIT_RADIUS etires de PitScale en x/z et de PIT_DEPTH en y ;
+// le dessus du plateau (BOARD_TOP) est perce la ou il coupe chaque bol
+const float PIT_RADIUS = 0.75f, PIT_DEPTH = 1.6f, BOARD_TOP = -0.4f;
+const int PIT_SECTORS = 48;
+glm::vec2 PitScale(int id) { return GameBoard::IsStore(id) ? glm::vec2(1.4f, 2.8f) : glm::vec2(1.15f, 1.35f); }
+
 unsigned int scoreTextureID;
 unsigned int circleTextureID;
 
+// Uniformes propres a chaque objet (emplacements releves une fois, voir InitSceneUniforms)
+struct SceneUniforms {
+    Uniform<glm::mat4> model;
+    Uniform<glm::vec3> objectColor;
+    Uniform<bool> useTexture, isText, isCircle, worldSpace;
+    Uniform<int> texture1, texture2;
+};
+SceneUniforms uniforms;
+FrameUniformBuffer frameUniforms; // Camera et eclairage : un seul envoi par image
+
 // --- PROTOTYPES ---
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 void mouse_callback(GLFWwindow* window, double xpos, double ypos);
@@ -299,36 +328,74 @@ void InitThemes() {
     themes.push_back(marble);
 }
 
-void DrawScore(Shader& shader, int number, glm::vec3 position, bool isStore) {
-    std::string s = std::to_string(number);
-    float scale = isStore ? 0.9f : 0.6f; float spacing = 0.4f * scale;
-
-    shader.setBool("isCircle", true); shader.setBool("isText", false);
-    float bgScale = (number > 9) ? scale * 3.0f : scale * 2.5f;
-    std::vector<Vertex> cv = {{{-0.5f, 0.0f, 0.5f}, {0,1,0}, {0,0}}, {{0.5f, 0.0f, 0.5f}, {0,1,0}, {1,0}}, {{0.5f, 0.0f, -0.5f}, {0,1,0}, {1,1}}, {{-0.5f, 0.0f, -0.5f}, {0,1,0}, {0,1}}};
-    std::vector<unsigned int> ci = {0,1,2, 0,2,3};
-    Mesh bgMesh(cv, ci);
-    glm::mat4 m = glm::mat4(1.0f); m = glm::translate(m, position); m = glm::scale(m, glm::vec3(bgScale, 1.0f, bgScale));
-    shader.setMat4("model", m); glBindTexture(GL_TEXTURE_2D, circleTextureID); bgMesh.Draw(shader.ID); bgMesh.Delete();
-
-    shader.setBool("isCircle", false); shader.setBool("isText", true); glBindTexture(GL_TEXTURE_2D, scoreTextureID);
-    float startX = -((s.length() - 1) * spacing) / 2.0f; position.y += 0.02f;
-    for (int i = 0; i < s.length(); i++) {
-        int d = s[i] - '0'; float us = d / 10.0f; float uw = 1.0f / 10.0f;
-        std::vector<Vertex> v = {{{-0.5f, 0.0f, 0.5f}, {0,1,0}, {us,0}}, {{0.5f, 0.0f, 0.5f}, {0,1,0}, {us+uw,0}}, {{0.5f, 0.0f, -0.5f}, {0,1,0}, {us+uw,1}}, {{-0.5f, 0.0f, -0.5f}, {0,1,0}, {us,1}}};
-        Mesh dm(v, ci);
-        m = glm::mat4(1.0f); m = glm::translate(m, position + glm::vec3(startX + i * spacing, 0.0f, 0.0f)); m = glm::scale(m, glm::vec3(scale * 0.6f, 1.0f, scale));
-        shader.setMat4("model", m); dm.Draw(shader.ID); dm.Delete();
+// --- ETIQUETTES (graines de chaque trou) ---
+// Tous les fonds puis tous les chiffres dans un seul tampon, en coordonnees du
+// monde : deux appels par image, et le tampon n'est reecrit que si un compte change
+const int LABEL_MAX_DIGITS = 3;
+const int LABEL_MAX_QUADS = GameBoard::NUM_PITS * (1 + LABEL_MAX_DIGITS);
+std::vector<Vertex> labelVertices;
+std::vector<unsigned int> labelIndices;
+size_t labelCircleIndices = 0;           // Indices des fonds, en tete ; les chiffres suivent
+uint8_t labelSeeds[GameBoard::NUM_PITS]; // Comptes affiches par le tampon
+bool labelsBuilt = false;
+
+glm::vec3 LabelPosition(const Pit& pit) {
+    glm::vec3 tp = pit.position; tp.y = -1.95f;
+    if (GameBoard::IsOwnPit(0, pit.id)) tp.z = 6.5f; else if (GameBoard::IsOwnPit(1, pit.id)) tp.z = -6.5f;
+    else if (pit.id == GameBoard::STORE_P1) { tp.x = 12.0f; tp.z = 0.0f; } else if (pit.id == GameBoard::STORE_P2) { tp.x = -12.0f; tp.z = 0.0f; }
+    return tp;
+}
+
+// Carre a plat (plan XZ) de sx par sz, colonne [u0, u1] de la texture
+void AddLabelQuad(glm::vec3 c, float sx, float sz, float u0, float u1) {
+    unsigned int base = (unsigned int)labelVertices.size();
+    labelVertices.push_back({c + glm::vec3(-0.5f * sx, 0.0f, 0.5f * sz), {0,1,0}, {u0,0}});
+    labelVertices.push_back({c + glm::vec3(0.5f * sx, 0.0f, 0.5f * sz), {0,1,0}, {u1,0}});
+    labelVertices.push_back({c + glm::vec3(0.5f * sx, 0.0f, -0.5f * sz), {0,1,0}, {u1,1}});
+    labelVertices.push_back({c + glm::vec3(-0.5f * sx, 0.0f, -0.5f * sz), {0,1,0}, {u0,1}});
+    unsigned int quad[] = {0,1,2, 0,2,3};
+    for (unsigned int i : quad) labelIndices.push_back(base + i);
+}
+
+void UpdateScoreLabels(DynamicMesh& mesh) {
+    if (labelsBuilt && std::memcmp(labelSeeds, game.board.seeds, sizeof(labelSeeds)) == 0) return;
+    labelVertices.clear(); labelIndices.clear();
+    for (const auto& pit : game.pits) { // Fonds (cercle semi-transparent)
+        int number = game.board.seeds[pit.id]; float scale = GameBoard::IsStore(pit.id) ? 0.9f : 0.6f;
+        float bgScale = (number > 9) ? scale * 3.0f : scale * 2.5f;
+        AddLabelQuad(LabelPosition(pit), bgScale, bgScale, 0.0f, 1.0f);
     }
+    labelCircleIndices = labelIndices.size();
+    for (const auto& pit : game.pits) { // Chiffres (atlas de CreateScoreTexture : 10 colonnes)
+        std::string s = std::to_string(game.board.seeds[pit.id]).substr(0, LABEL_MAX_DIGITS);
+        float scale = GameBoard::IsStore(pit.id) ? 0.9f : 0.6f; float spacing = 0.4f * scale;
+        glm::vec3 position = LabelPosition(pit); position.y += 0.02f;
+        float startX = -((s.length() - 1) * spacing) / 2.0f;
+        for (size_t i = 0; i < s.length(); i++) {
+            float us = (s[i] - '0') / 10.0f; float uw = 1.0f / 10.0f;
+            AddLabelQuad(position + glm::vec3(startX + i * spacing, 0.0f, 0.0f), scale * 0.6f, scale, us, us + uw);
+        }
+    }
+    mesh.Update(labelVertices, labelIndices);
+    std::memcpy(labelSeeds, game.board.seeds, sizeof(labelSeeds)); labelsBuilt = true;
+}
+
+void DrawScoreLabels(Shader& shader, DynamicMesh& mesh) {
+    shader.set(uniforms.model, glm::mat4(1.0f)); // Sommets deja places
+    shader.set(uniforms.isCircle, true); shader.set(uniforms.isText, false);
+    glBindTexture(GL_TEXTURE_2D, circleTextureID); mesh.DrawRange(0, labelCircleIndices);
+    shader.set(uniforms.isCircle, false); shader.set(uniforms.isText, true);
+    glBindTexture(GL_TEXTURE_2D, scoreTextureID); mesh.DrawRange(labelCircleIndices, labelIndices.size() - labelCircleIndices);
+    shader.set(uniforms.isText, false);
 }
 
 void RegenerateSeedVisuals() {
     pitSeedsVisuals.clear(); srand(time(0));
-    for(int i=0; i<14; i++) {
+    for(int i=0; i<GameBoard::NUM_PITS; i++) {
         std::vector<SeedVisual> visuals;
         for(int s=0; s<60; s++) {
             SeedVisual sv; float spacing = 0.22f; float radius = spacing * sqrt(s + 0.5f); float angle = s * 2.39996f;
-            if (i == 6 || i == 13) { sv.offset.x = (radius * 0.9f) * cos(angle); sv.offset.z = (radius * 2.0f) * sin(angle); float d = sqrt(sv.offset.x*sv.offset.x+sv.offset.z*sv.offset.z); sv.offset.y = -0.15f + (d * 0.12f); }
+            if (GameBoard::IsStore(i)) { sv.offset.x = (radius * 0.9f) * cos(angle); sv.offset.z = (radius * 2.0f) * sin(angle); float d = sqrt(sv.offset.x*sv.offset.x+sv.offset.z*sv.offset.z); sv.offset.y = -0.15f + (d * 0.12f); }
             else { sv.offset.x = (radius * 1.15f) * cos(angle); sv.offset.z = radius * sin(angle); sv.offset.y = -0.30f + (radius * radius * 0.9f); }
             float j = 0.02f; sv.offset.x += ((rand()%100)/100.0f*j)-(j/2); sv.offset.z += ((rand()%100)/100.0f*j)-(j/2);
             sv.colorType = rand() % 3; visuals.push_back(sv);
@@ -337,12 +404,111 @@ void RegenerateSeedVisuals() {
     }
 }
 
+void InitSceneUniforms(Shader& shader) {
+    uniforms.model = shader.getUniform<glm::mat4>("model");
+    uniforms.objectColor = shader.getUniform<glm::vec3>("objectColor");
+    uniforms.useTexture = shader.getUniform<bool>("useTexture");
+    uniforms.isText = shader.getUniform<bool>("isText");
+    uniforms.isCircle = shader.getUniform<bool>("isCircle");
+    uniforms.worldSpace = shader.getUniform<bool>("worldSpace");
+    uniforms.texture1 = shader.getUniform<int>("texture1");
+    uniforms.texture2 = shader.getUniform<int>("texture2");
+    shader.use(); shader.set(uniforms.texture1, 0); shader.set(uniforms.texture2, 1); // Toujours les unites 0 et 1
+    frameUniforms.create();
+}
+
+void InitSeedInstances(Mesh& seedMesh) {
+    glGenBuffers(1, &seedInstanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, seedInstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, SEED_INSTANCE_CAPACITY * sizeof(InstanceData), NULL, GL_DYNAMIC_DRAW);
+    seedMesh.SetInstanceBuffer(seedInstanceVBO);
+    seedInstances.reserve(SEED_INSTANCE_CAPACITY);
+}
+
+// Tampon des graines reecrit seulement quand un compte (ou le theme) change ; renvoie le nombre de graines posees
+int UpdateSeedInstances() {
+    if (shownSeedTheme == currentThemeIdx && std::memcmp(shownSeeds, game.board.seeds, sizeof(shownSeeds)) == 0) return (int)seedInstances.size();
+    const Theme& theme = themes[currentThemeIdx];
+    seedInstances.clear();
+    for(const auto& pit : game.pits) {
+        if (pit.isHidden) continue;
+        for(int s = 0; s < game.board.seeds[pit.id] && (int)seedInstances.size() < SEED_INSTANCE_CAPACITY - 1; s++) {
+            const SeedVisual& sv = pitSeedsVisuals[pit.id][s % 60];
+            seedInstances.push_back({pit.position + sv.offset, theme.seedColors[sv.colorType]}); // Couleur graine selon le theme
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, seedInstanceVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, seedInstances.size() * sizeof(InstanceData), seedInstances.data());
+    std::memcpy(shownSeeds, game.board.seeds, sizeof(shownSeeds)); shownSeedTheme = currentThemeIdx;
+    return (int)seedInstances.size();
+}
+
+// Plateau (cotes et dessus perce), 4 bordures puis table, places une fois pour toutes
+// (dans cet ordre, voir UpdateStaticScene)
+Mesh BakeStaticScene(const Mesh& boxMesh, const Mesh& tableMesh) {
+    auto box = [](glm::vec3 position, glm::vec3 size) { return glm::scale(glm::translate(glm::mat4(1.0f), position), size); };
+    std::vector<glm::vec4> holes;
+    for(const auto& pit : game.pits) {
+        if (pit.isHidden) continue;
+        float y = (BOARD_TOP - pit.position.y) / PIT_DEPTH; // Hauteur du dessus dans le bol non etire
+        float r = sqrt(std::max(PIT_RADIUS * PIT_RADIUS - y * y, 0.0f));
+        glm::vec2 scale = PitScale(pit.id);
+        holes.push_back(glm::vec4(pit.position.x, pit.position.z, r * scale.x, r * scale.y));
+    }
+    Mesh sides = Geometry::CreateCube(false); // Dessous jamais vu (et confondu avec le fond des bols)
+    Mesh top = Geometry::CreateBoardTop(glm::vec2(19.0f, 7.8f), holes, PIT_SECTORS);
+    staticSceneBoardEnd = sides.vertices.size() + top.vertices.size();
+    staticSceneBordersEnd = staticSceneBoardEnd + 4 * boxMesh.vertices.size();
+    Mesh scene = Geometry::Bake({
+        {&sides, box(glm::vec3(0.0f, -0.8f, 0.0f), glm::vec3(19.0f, 0.8f, 7.8f))},
+        {&top, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, BOARD_TOP, 0.0f))},
+        {&boxMesh, box(glm::vec3(-9.8f, -0.5f, 0.0f), glm::vec3(0.6f, 1.1f, 8.0f))},
+        {&boxMesh, box(glm::vec3(9.8f, -0.5f, 0.0f), glm::vec3(0.6f, 1.1f, 8.0f))},
+        {&boxMesh, box(glm::vec3(0.0f, -0.5f, -4.1f), glm::vec3(19.0f, 1.1f, 0.6f))},
+        {&boxMesh, box(glm::vec3(0.0f, -0.5f, 4.1f), glm::vec3(19.0f, 1.1f, 0.6f))},
+        {&tableMesh, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -2.0f, 0.0f))}
+    });
+    sides.Delete(); top.Delete();
+    return scene;
+}
+
+// Teintes de la scene fixe reecrites seulement au changement de theme
+void UpdateStaticScene(Mesh& scene) {
+    if (staticSceneTheme == currentThemeIdx) return;
+    const Theme& theme = themes[currentThemeIdx];
+    std::vector<VertexTint> tints;
+    tints.resize(staticSceneBoardEnd, {theme.boardTint, 0.0f});
+    tints.resize(staticSceneBordersEnd, {theme.boardTint * 0.85f, 0.0f}); // Bordures un peu plus sombres
+    tints.resize(scene.vertices.size(), {glm::vec3(1.0f), 1.0f}); // Table : sa propre texture (unite 1), sans teinte
+    scene.SetVertexTints(tints);
+    staticSceneTheme = currentThemeIdx;
+}
+
 void UpdateWindowTitle(GLFWwindow* window) {
-    std::string title = "Mancala 3D [" + themes[currentThemeIdx].name + "] [Eclairage: " + lightingNames[lightingMode] + "] | " + game.statusMessage + " | (T) Theme | (L) Eclairage";
+    // Titre reconstruit seulement quand il change (pas d'allocation a chaque image)
+    static std::string shownStatus; static int shownTheme = -1; static int shownLighting = -1; static int shownAI = -1; static int shownEngine = -1; static int shownHints = -2;
+    int hintDepth = game.showHints ? game.hintScores.depth : -1;
+    if (shownStatus == game.statusMessage && shownTheme == currentThemeIdx && shownLighting == lightingMode && shownAI == (int)game.aiPlays[1] && shownEngine == (int)game.aiEngine && shownHints == hintDepth) return;
+    shownStatus = game.statusMessage; shownTheme = currentThemeIdx; shownLighting = lightingMode; shownAI = (int)game.aiPlays[1]; shownEngine = (int)game.aiEngine; shownHints = hintDepth;
+    std::string title = "Mancala 3D [" + themes[currentThemeIdx].name + "] [Eclairage: " + lightingNames[lightingMode] + "] [J2: " + (game.IsRemote() ? "En ligne" : game.aiPlays[1] ? (game.aiEngine == ENGINE_MCTS ? "Ordinateur MCTS" : "Ordinateur") : "Humain") + "]" + (hintDepth >= 0 ? " [Conseils: profondeur " + std::to_string(hintDepth) + "]" : "") + " | " + game.statusMessage + " | (T) Theme | (L) Eclairage | (I) IA | (M) Moteur | (U/R) Annuler/Refaire | (H) Conseils";
     glfwSetWindowTitle(window, title.c_str());
 }
 
-int main() {
+// mancala [--connect ADRESSE] [--vs-ai] [--net FICHIER] : sans option, partie locale ; avec --connect,
+// client du serveur de parties (mancala-headless server), contre un autre client ou son ordinateur.
+// --net : valuation de l'ordinateur par le rseau (plus fort  profondeur gale, mais ~30 %
+// de noeuds en moins dans le mme temps), seulement sur demande
+int main(int argc, char** argv) {
+    std::string serverAddress, netPath;
+    bool serverAI = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--connect" && i + 1 < argc) serverAddress = argv[++i];
+        else if (arg == "--vs-ai") serverAI = true;
+        else if (arg == "--net" && i + 1 < argc) netPath = argv[++i];
+        else std::cout << "Option ignoree : " << arg << std::endl;
+    }
+
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3); glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3); glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE); glfwWindowHint(GLFW_SAMPLES, 8);
     GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Mancala 3D", NULL, NULL);
@@ -351,18 +517,33 @@ int main() {
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback); glfwSetCursorPosCallback(window, mouse_callback); glfwSetScrollCallback(window, scroll_callback); glfwSetMouseButtonCallback(window, mouse_button_callback); glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
     if (glewInit() != GLEW_OK) return -1;
 
-    glEnable(GL_DEPTH_TEST); glEnable(GL_STENCIL_TEST); glEnable(GL_MULTISAMPLE); glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+    glEnable(GL_DEPTH_TEST); glEnable(GL_MULTISAMPLE); glEnable(GL_BLEND); glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     Shader shader("shaders/vertex.glsl", "shaders/fragment.glsl");
-    Mesh boardMesh = Geometry::CreateCube(); Mesh pitInteriorMesh = Geometry::CreateBowl(0.75f, 48, 24); Mesh seedMesh = Geometry::CreateSphere(0.22f); Mesh tableMesh = Geometry::CreatePlane();
+    Mesh boardMesh = Geometry::CreateCube(); Mesh pitInteriorMesh = Geometry::CreateBowl(PIT_RADIUS, PIT_SECTORS, 24); Mesh seedMesh = Geometry::CreateSphere(0.22f); Mesh tableMesh = Geometry::CreatePlane();
+    DynamicMesh labelMesh(LABEL_MAX_QUADS * 4, LABEL_MAX_QUADS * 6);
+    Mesh staticScene = BakeStaticScene(boardMesh, tableMesh);
 
     scoreTextureID = CreateScoreTexture();
     circleTextureID = CreateCircleTexture();
+    InitSceneUniforms(shader);
+    InitSeedInstances(seedMesh);
 
     // Initialisation des thmes
     InitThemes();
     RegenerateSeedVisuals();
 
+    // Base de finales facultative (generee par : mancala-headless egtb)
+    if (game.endgame.Open("kalah6.egdb")) std::cout << "Base de finales : " << game.endgame.MaxSeeds() << " graines en jeu max" << std::endl;
+    // Livre d'ouvertures facultatif (genere par : mancala-headless book)
+    if (game.book.Open("kalah6x4.book")) std::cout << "Livre d'ouvertures : " << game.book.Size() << " positions" << std::endl;
+    // Reseau d'evaluation facultatif (entraine par : mancala-headless train), seulement avec --net
+    if (!netPath.empty() && game.OpenNet(netPath)) std::cout << "Reseau d'evaluation : " << netPath << std::endl;
+    // Archive des parties jouees (relue par : mancala-headless games kalah6x4.games)
+    game.recorder.Open<GameBoard>("kalah6x4.games");
+    // Partie en ligne : en cas d'echec, on reste sur une partie locale
+    if (!serverAddress.empty() && !game.ConnectRemote(serverAddress, serverAI)) std::cout << "Partie locale" << std::endl;
+
     while (!glfwWindowShouldClose(window)) {
         float currentFrame = glfwGetTime(); deltaTime = currentFrame - lastFrame; lastFrame = currentFrame;
         processInput(window); game.Update(deltaTime);
@@ -373,9 +554,8 @@ int main() {
         UpdateWindowTitle(window);
         Theme& currentTheme = themes[currentThemeIdx];
 
-        glStencilMask(0xFF);
         glClearColor(currentTheme.bgColor.r, currentTheme.bgColor.g, currentTheme.bgColor.b, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
         glm::mat4 view = camera.GetViewMatrix();
@@ -400,72 +580,47 @@ int main() {
             ambientStrength = 0.40f; // Trs lumineux
         }
 
-        shader.use(); shader.setMat4("projection", projection); shader.setMat4("view", view);
-        shader.setVec3("viewPos", camera.Position);
-        shader.setVec3("lightPos", lightPos);
-        shader.setVec3("lightColor", lightColor);
-        shader.setFloat("ambientStrength", ambientStrength); // Passe l'clairage ambiant au shader
-        shader.setBool("isText", false); shader.setBool("isCircle", false);
+        FrameUniforms frame;
+        frame.projection = projection; frame.view = view; frame.viewPos = camera.Position;
+        frame.lightPos = lightPos; frame.lightColor = lightColor;
+        frame.ambientStrength = ambientStrength; // Passe l'clairage ambiant au shader
+        frameUniforms.update(frame);
+        shader.use();
 
         // --- Rendu ---
 
-        // 1. Pochoir
-        glStencilFunc(GL_ALWAYS, 1, 0xFF); glStencilMask(0xFF); glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE); glDepthMask(GL_FALSE); shader.setBool("useTexture", false);
-        for(const auto& pit : game.pits) {
-            if (pit.isHidden) continue;
-            glm::mat4 m = glm::mat4(1.0f); m = glm::translate(m, pit.position); float sx = (pit.id==6||pit.id==13)?1.4f:1.15f; float sz = (pit.id==6||pit.id==13)?2.8f:1.35f; m = glm::scale(m, glm::vec3(sx, 1.0f, sz)); shader.setMat4("model", m); pitInteriorMesh.Draw(shader.ID);
-        }
-
-        // 2. Plateau (Theme Actif)
-        glStencilFunc(GL_NOTEQUAL, 1, 0xFF); glStencilMask(0x00); glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE); glDepthMask(GL_TRUE);
+        // 1. Plateau perce, bordures et table (Theme Actif) : un seul appel, deja places
+        glActiveTexture(GL_TEXTURE1); glBindTexture(GL_TEXTURE_2D, currentTheme.tableTexID);
         glActiveTexture(GL_TEXTURE0); glBindTexture(GL_TEXTURE_2D, currentTheme.boardTexID);
-        shader.setInt("texture1", 0); shader.setBool("useTexture", true);
-        shader.setVec3("objectColor", currentTheme.boardTint);
-
-        glm::mat4 m = glm::mat4(1.0f); m = glm::translate(m, glm::vec3(0.0f, -0.8f, 0.0f)); m = glm::scale(m, glm::vec3(19.0f, 0.8f, 7.8f)); shader.setMat4("model", m); boardMesh.Draw(shader.ID);
-        // Bordures
-        shader.setVec3("objectColor", currentTheme.boardTint * 0.85f); // Un peu plus sombre
-        m = glm::mat4(1.0f); m = glm::translate(m, glm::vec3(-9.8f, -0.5f, 0.0f)); m = glm::scale(m, glm::vec3(0.6f, 1.1f, 8.0f)); shader.setMat4("model", m); boardMesh.Draw(shader.ID);
-        m = glm::mat4(1.0f); m = glm::translate(m, glm::vec3(9.8f, -0.5f, 0.0f)); m = glm::scale(m, glm::vec3(0.6f, 1.1f, 8.0f)); shader.setMat4("model", m); boardMesh.Draw(shader.ID);
-        m = glm::mat4(1.0f); m = glm::translate(m, glm::vec3(0.0f, -0.5f, -4.1f)); m = glm::scale(m, glm::vec3(19.0f, 1.1f, 0.6f)); shader.setMat4("model", m); boardMesh.Draw(shader.ID);
-        m = glm::mat4(1.0f); m = glm::translate(m, glm::vec3(0.0f, -0.5f, 4.1f)); m = glm::scale(m, glm::vec3(19.0f, 1.1f, 0.6f)); shader.setMat4("model", m); boardMesh.Draw(shader.ID);
-
-        // 3. Table (Theme Actif)
-        glStencilFunc(GL_ALWAYS, 1, 0xFF); glBindTexture(GL_TEXTURE_2D, currentTheme.tableTexID); shader.setBool("useTexture", true); shader.setVec3("objectColor", glm::vec3(1.0f));
-        m = glm::mat4(1.0f); m = glm::translate(m, glm::vec3(0.0f, -2.0f, 0.0f)); shader.setMat4("model", m); tableMesh.Draw(shader.ID);
-
-        // 4. Interieur Trous + Graines
-        shader.setBool("useTexture", false);
+        UpdateStaticScene(staticScene);
+        shader.set(uniforms.useTexture, true);
+        shader.set(uniforms.worldSpace, true); staticScene.Draw(shader.ID); shader.set(uniforms.worldSpace, false);
+
+        // 2. Interieur Trous + Graines
+        shader.set(uniforms.useTexture, false);
         for(const auto& pit : game.pits) {
             if (pit.isHidden) continue;
-            float sx = (pit.id==6||pit.id==13)?1.4f:1.15f; float sz = (pit.id==6||pit.id==13)?2.8f:1.35f;
-            glm::mat4 hm = glm::mat4(1.0f); hm = glm::translate(hm, pit.position); hm = glm::scale(hm, glm::vec3(sx, 1.6f, sz)); shader.setMat4("model", hm);
+            glm::vec2 scale = PitScale(pit.id);
+            glm::mat4 hm = glm::mat4(1.0f); hm = glm::translate(hm, pit.position); hm = glm::scale(hm, glm::vec3(scale.x, PIT_DEPTH, scale.y)); shader.set(uniforms.model, hm);
             glm::vec3 pitColor = currentTheme.boardTint * 0.65f; // Plus sombre
-            if (pit.isHovered && pit.isActive) pitColor = currentTheme.boardTint * 0.85f;
-            shader.setVec3("objectColor", pitColor); pitInteriorMesh.Draw(shader.ID);
-
-            for(int s = 0; s < pit.seeds; s++) {
-                SeedVisual& sv = pitSeedsVisuals[pit.id][s % 60];
-                m = glm::mat4(1.0f); m = glm::translate(m, pit.position + sv.offset); m = glm::scale(m, glm::vec3(1.0f)); shader.setMat4("model", m);
-                // Couleur graine selon le theme
-                glm::vec3 seedColor = currentTheme.seedColors[sv.colorType];
-                shader.setVec3("objectColor", seedColor); seedMesh.Draw(shader.ID);
-            }
+            // Conseils : du rouge (coup perdant) au vert (meilleur coup), sur la teinte du trou
+            float hintQuality;
+            if (pit.isActive && game.HintQuality(pit.id, hintQuality)) pitColor = glm::mix(pitColor, glm::mix(glm::vec3(0.75f, 0.15f, 0.1f), glm::vec3(0.2f, 0.75f, 0.25f), hintQuality), 0.6f);
+            if (pit.isHovered && pit.isActive) pitColor *= 1.3f;
+            shader.set(uniforms.objectColor, pitColor); pitInteriorMesh.Draw(shader.ID);
         }
+        // Toutes les graines en un appel ; seule la graine en mouvement est reecrite a chaque image
+        int seedCount = UpdateSeedInstances();
         if (game.state == ANIMATING) {
-            m = glm::mat4(1.0f); m = glm::translate(m, game.activeSeed.currentPos); m = glm::scale(m, glm::vec3(1.0f)); shader.setMat4("model", m);
-            shader.setVec3("objectColor", glm::vec3(1.0f, 0.85f, 0.3f)); seedMesh.Draw(shader.ID);
+            InstanceData moving = {game.activeSeed.currentPos, glm::vec3(1.0f, 0.85f, 0.3f)};
+            glBindBuffer(GL_ARRAY_BUFFER, seedInstanceVBO); glBufferSubData(GL_ARRAY_BUFFER, seedCount * sizeof(InstanceData), sizeof(InstanceData), &moving);
+            seedCount++;
         }
+        shader.set(uniforms.worldSpace, true); seedMesh.DrawInstanced(seedCount); shader.set(uniforms.worldSpace, false);
 
-        // 5. Scores
-        shader.setBool("useTexture", true);
-        for(const auto& pit : game.pits) {
-            glm::vec3 tp = pit.position; tp.y = -1.95f;
-            if (pit.id >= 0 && pit.id <= 5) tp.z = 6.5f; else if (pit.id >= 7 && pit.id <= 12) tp.z = -6.5f;
-            else if (pit.id == 6) { tp.x = 12.0f; tp.z = 0.0f; } else if (pit.id == 13) { tp.x = -12.0f; tp.z = 0.0f; }
-            DrawScore(shader, pit.seeds, tp, (pit.id==6||pit.id==13));
-        }
-        shader.setBool("isText", false); shader.setBool("isCircle", false);
+        // 3. Scores
+        shader.set(uniforms.useTexture, true);
+        UpdateScoreLabels(labelMesh); DrawScoreLabels(shader, labelMesh);
 
         glfwSwapBuffers(window); glfwPollEvents();
     }
@@ -493,6 +648,53 @@ void processInput(GLFWwindow *window) {
         lPressed = true;
     }
     if (glfwGetKey(window, GLFW_KEY_L) == GLFW_RELEASE) lPressed = false;
+
+    // --- ORDINATEUR POUR LE JOUEUR 2 (I) ---
+    static bool iPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_I) == GLFW_PRESS && !iPressed) {
+        game.SetAIPlayer(1, !game.aiPlays[1]);
+        iPressed = true;
+    }
+    if (glfwGetKey(window, GLFW_KEY_I) == GLFW_RELEASE) iPressed = false;
+
+    // --- CONSEILS : TROUS TEINTES SELON LE SCORE DE LEUR COUP (H) ---
+    static bool hPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_H) == GLFW_PRESS && !hPressed) {
+        game.SetHints(!game.showHints);
+        hPressed = true;
+    }
+    if (glfwGetKey(window, GLFW_KEY_H) == GLFW_RELEASE) hPressed = false;
+
+    // --- MOTEUR DE L'ORDINATEUR : ALPHA-BETA / MCTS (M) ---
+    static bool mPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS && !mPressed) {
+        game.SetAIEngine(game.aiEngine == ENGINE_MCTS ? ENGINE_ALPHABETA : ENGINE_MCTS);
+        mPressed = true;
+    }
+    if (glfwGetKey(window, GLFW_KEY_M) == GLFW_RELEASE) mPressed = false;
+
+    // --- HISTORIQUE : ANNULER (U) / REFAIRE (R), COUP PAR COUP (Gauche / Droite), DEBUT / FIN ---
+    static bool historyPressed = false;
+    bool undoKey = glfwGetKey(window, GLFW_KEY_U) == GLFW_PRESS, redoKey = glfwGetKey(window, GLFW_KEY_R) == GLFW_PRESS;
+    bool leftKey = glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS, rightKey = glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS;
+    bool homeKey = glfwGetKey(window, GLFW_KEY_HOME) == GLFW_PRESS, endKey = glfwGetKey(window, GLFW_KEY_END) == GLFW_PRESS;
+    if (!historyPressed) {
+        if (undoKey) game.Undo();
+        else if (redoKey) game.Redo();
+        else if (leftKey) game.JumpToPly(game.history.Ply() - 1);
+        else if (rightKey) game.JumpToPly(game.history.Ply() + 1);
+        else if (homeKey) game.JumpToPly(0);
+        else if (endKey) game.JumpToPly(game.history.Length());
+    }
+    historyPressed = undoKey || redoKey || leftKey || rightKey || homeKey || endKey;
+
+    // --- EN LIGNE : NOUVELLE PARTIE (N) ---
+    static bool nPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_N) == GLFW_PRESS && !nPressed) {
+        game.JoinRemote();
+        nPressed = true;
+    }
+    if (glfwGetKey(window, GLFW_KEY_N) == GLFW_RELEASE) nPressed = false;
 }
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) { camRadius -= (float)yoffset * 2.0f; if (camRadius < 10.0f) camRadius = 10.0f; if (camRadius > 50.0f) camRadius = 50.0f; }
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) { if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS && cursorEnabled) { glm::mat4 p = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f); glm::mat4 v = camera.GetViewMatrix(); game.ProcessClick(camera.Position, GetMouseRay(window, p, v), false); } }
@@ -2,19 +2,44 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in vec3 aOffset;  // Par instance (graines)
+layout (location = 4) in vec3 aColor;   // Par instance (graines) ou par sommet (scene fixe)
+layout (location = 5) in float aTexture; // Par sommet (scene fixe) : 0 = texture1, 1 = texture2
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
+out vec3 InstanceColor;
+out float TextureIndex;
+
+// Commun a toute l'image (FrameUniforms dans Shader.hpp)
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    vec3 viewPos;
+    vec3 lightPos;
+    vec3 lightColor;
+    float ambientStrength;
+};
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// Sommets deja places, sans 'model' : graines (decalage et couleur par instance)
+// et scene fixe (coordonnees du monde, couleur et texture par sommet, decalage nul)
+uniform bool worldSpace;
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    if (worldSpace) {
+        FragPos = aPos + aOffset; // Translation seule : la normale ne change pas
+        Normal = aNormal;
+        InstanceColor = aColor;
+        TextureIndex = aTexture;
+    } else {
+        FragPos = vec3(model * vec4(aPos, 1.0));
+        Normal = mat3(transpose(inverse(model))) * aNormal;
+        InstanceColor = vec3(0.0);
+        TextureIndex = 0.0;
+    }
     TexCoords = aTexCoords;
 
     gl_Position = projection * view * vec4(FragPos, 1.0);